@@ -37,7 +37,9 @@ def ratio_to_string(ratio):
     return ratio_str
 
 
-if __name__ == '__main__':
+# Calculates the common ratio for every table size
+# from 2^7 to 2^64 buckets and returns them in a list.
+def calculate_common_ratios():
     
     # an array to hold the results
     ratios = []
@@ -55,6 +57,13 @@ if __name__ == '__main__':
             fract /= 10
         ratios.append(round(ratio, decimal_places))
     
+    return ratios
+
+
+if __name__ == '__main__':
+    
+    ratios = calculate_common_ratios()
+    
     # print the array of common ratios to stdout in a format
     # that we can use to copy-and-paste it into our c code.
     print(f'#define NUM_COMMON_RATIOS   {len(ratios)}')
@@ -5,13 +5,21 @@
 //          https://www.boost.org/LICENSE_1_0.txt)
 
 #include <benchmark/benchmark.h>
+#include <thread>
+#include <vector>
 #include "ska/bytell_hash_map.hpp"
 #include "geoseq_unordered_flatmap56.h"
+#include "geoseq_unordered_flatmap56_core.h"
 
 
 #define MAX_COUNT 5000000
 int myarray[MAX_COUNT];
 
+FLATMAP56_DEFINE(flatmap56_int, int)
+uint64_t mykeys[MAX_COUNT];
+void* myvalues[MAX_COUNT];
+int myremoved[MAX_COUNT];
+
 
 static void geoseq_flatmap56_insert(benchmark::State& state) {
     size_t range = state.range(0);
@@ -31,6 +39,98 @@ static void geoseq_flatmap56_insert(benchmark::State& state) {
 BENCHMARK(geoseq_flatmap56_insert)->Name("geoseq_flatmap56_insert")->DenseRange(10000, MAX_COUNT, 25000)->Unit(benchmark::kNanosecond);
 
 
+// fills a new table every iteration, with (second argument 1) or without (0) reserving room first
+static void geoseq_flatmap56_insert_reserved(benchmark::State& state) {
+    size_t range = state.range(0);
+    int *value;
+    flatmap56_t* map = NULL;
+    for (auto _ : state){
+        state.PauseTiming();
+        flatmap56_destroy(map);
+        map = flatmap56_create(0,sizeof(int));
+        state.ResumeTiming();
+        if(state.range(1)) flatmap56_reserve(map, range);
+        for(size_t i = 0; i < range; i++){
+            value = (int*)flatmap56_insert(map, myarray[i]);
+            *value = myarray[i];
+        }
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_insert_reserved)->Name("geoseq_flatmap56_insert_reserved")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {0, 1}})->Unit(benchmark::kNanosecond);
+
+
+// fills a new table every iteration without (second argument 0) or with (1) an occupancy bitmap
+static void geoseq_flatmap56_insert_bitmap(benchmark::State& state) {
+    size_t range = state.range(0);
+    int *value;
+    flatmap56_t* map = NULL;
+    for (auto _ : state){
+        state.PauseTiming();
+        flatmap56_destroy(map);
+        map = flatmap56_create_ex(0,sizeof(int),state.range(1) ? FLATMAP56_OCCUPANCY_BITMAP : 0,NULL);
+        state.ResumeTiming();
+        for(size_t i = 0; i < range; i++){
+            value = (int*)flatmap56_insert(map, myarray[i]);
+            *value = myarray[i];
+        }
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_insert_bitmap)->Name("geoseq_flatmap56_insert_bitmap")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {0, 1}})->Unit(benchmark::kNanosecond);
+
+
+// builds a new table every iteration from the key and value arrays; the second argument is the number of threads
+static void geoseq_flatmap56_build(benchmark::State& state) {
+    size_t range = state.range(0);
+    flatmap56_t* map = NULL;
+    for (auto _ : state){
+        state.PauseTiming();
+        flatmap56_destroy(map);
+        map = flatmap56_create(0,sizeof(int));
+        state.ResumeTiming();
+        flatmap56_build(map, mykeys, myarray, range, state.range(1));
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_build)->Name("geoseq_flatmap56_build")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {1, 2, 4, 8}})->Unit(benchmark::kNanosecond)->UseRealTime();
+
+
+// doubles a filled table every iteration; the second argument is policy.rehash_threads
+static void geoseq_flatmap56_resize(benchmark::State& state) {
+    size_t range = state.range(0);
+    int *value;
+    flatmap56_policy_t policy = flatmap56_default_policy();
+    policy.rehash_threads = state.range(1);
+    policy.never_shrink = true;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),0,&policy);
+    for(size_t i = 0; i < range; i++){
+        value = (int*)flatmap56_insert(map, myarray[i]);
+        *value = myarray[i];
+    }
+    for (auto _ : state){
+        flatmap56_resize(map,1);
+        state.PauseTiming();
+        flatmap56_resize(map,-1);
+        state.ResumeTiming();
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_resize)->Name("geoseq_flatmap56_resize")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {1, 2, 4, 8}})->Unit(benchmark::kNanosecond)->UseRealTime();
+
+
 static void geoseq_flatmap56_lookup(benchmark::State& state) {
     size_t range = state.range(0);
     int *value;
@@ -51,6 +151,289 @@ static void geoseq_flatmap56_lookup(benchmark::State& state) {
 BENCHMARK(geoseq_flatmap56_lookup)->Name("geoseq_flatmap56_lookup")->DenseRange(10000, MAX_COUNT, 25000)->Unit(benchmark::kNanosecond);
 
 
+// looks every key up in a split (second argument 0) or grouped (1) layout table
+static void geoseq_flatmap56_lookup_grouped(benchmark::State& state) {
+    size_t range = state.range(0);
+    int *value;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),state.range(1) ? FLATMAP56_GROUPED_LAYOUT : FLATMAP56_SPLIT_LAYOUT,NULL);
+    for(size_t i = 0; i < range; i++){
+        value = (int*)flatmap56_insert(map, myarray[i]);
+        *value = myarray[i];
+    }
+    for (auto _ : state){
+        for(size_t i = 0; i < range; i++)
+            benchmark::DoNotOptimize(flatmap56_lookup(map, myarray[i]));
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_lookup_grouped)->Name("geoseq_flatmap56_lookup_grouped")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {0, 1}})->Unit(benchmark::kNanosecond);
+
+
+static void geoseq_flatmap56_iterate(benchmark::State& state) {
+    size_t range = state.range(0);
+    int *value;
+    uint64_t key;
+    void* v;
+    flatmap56_iter_t iter;
+    flatmap56_t* map = flatmap56_create(0,sizeof(int));
+    for(size_t i = 0; i < range; i++){
+        value = (int*)flatmap56_insert(map, myarray[i]);
+        *value = myarray[i];
+    }
+    for (auto _ : state){
+        for(flatmap56_iter_begin(map, &iter); flatmap56_iter_next(&iter, &key, &v);)
+            benchmark::DoNotOptimize(v);
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_iterate)->Name("geoseq_flatmap56_iterate")->DenseRange(10000, MAX_COUNT, 25000)->Unit(benchmark::kNanosecond);
+
+
+static void sum_values(uint64_t key, void* value, void* ctx, uint64_t thread) {
+    ((int64_t*)ctx)[thread * 8] += *(int*)value; // one cache line per thread
+}
+
+// sums every value of the table; the second argument is the number of threads
+static void geoseq_flatmap56_parallel_for_each(benchmark::State& state) {
+    size_t range = state.range(0);
+    int *value;
+    int64_t sums[8 * 8];
+    flatmap56_t* map = flatmap56_create(0,sizeof(int));
+    for(size_t i = 0; i < range; i++){
+        value = (int*)flatmap56_insert(map, myarray[i]);
+        *value = myarray[i];
+    }
+    for (auto _ : state){
+        memset(sums, 0, sizeof(sums));
+        flatmap56_parallel_for_each(map, sum_values, sums, state.range(1));
+        benchmark::DoNotOptimize(sums);
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_parallel_for_each)->Name("geoseq_flatmap56_parallel_for_each")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {1, 2, 4, 8}})->Unit(benchmark::kNanosecond)->UseRealTime();
+
+
+// looks every key up with flatmap56_read() from several threads at once, each reading its own
+// slice of the keys; the second argument is the number of threads
+static void geoseq_flatmap56_concurrent_read(benchmark::State& state) {
+    size_t range = state.range(0);
+    size_t nthreads = state.range(1);
+    std::vector<std::thread> threads;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_CONCURRENT,NULL);
+    for(size_t i = 0; i < range; i++) flatmap56_write(map, myarray[i], &myarray[i]);
+    for (auto _ : state){
+        for(size_t t = 0; t < nthreads; t++){
+            threads.emplace_back([map, range, nthreads, t]{
+                int value;
+                for(size_t i = t * range / nthreads; i < (t + 1) * range / nthreads; i++){
+                    flatmap56_read(map, myarray[i], &value);
+                    benchmark::DoNotOptimize(value);
+                }
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        threads.clear();
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_concurrent_read)->Name("geoseq_flatmap56_concurrent_read")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {1, 2, 4, 8}})->Unit(benchmark::kNanosecond)->UseRealTime();
+
+
+// the same reads while a writer thread rebuilds the table back and forth between two sizes the
+// whole time; readers keep using the published table during every rebuild
+static void geoseq_flatmap56_concurrent_read_resizing(benchmark::State& state) {
+    size_t range = state.range(0);
+    size_t nthreads = state.range(1);
+    std::vector<std::thread> threads;
+    bool done = false;
+    uint64_t resizes = 0;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_CONCURRENT,NULL);
+    for(size_t i = 0; i < range; i++) flatmap56_write(map, myarray[i], &myarray[i]);
+    std::thread writer([map, range, &done, &resizes]{
+        while(!__atomic_load_n(&done, __ATOMIC_ACQUIRE)){
+            flatmap56_reserve(map, 2 * range);
+            flatmap56_reserve(map, 0);
+            flatmap56_shrink_to_fit(map);
+            resizes += 2;
+        }
+    });
+    for (auto _ : state){
+        for(size_t t = 0; t < nthreads; t++){
+            threads.emplace_back([map, range, nthreads, t]{
+                int value;
+                for(size_t i = t * range / nthreads; i < (t + 1) * range / nthreads; i++){
+                    flatmap56_read(map, myarray[i], &value);
+                    benchmark::DoNotOptimize(value);
+                }
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        threads.clear();
+    }
+    __atomic_store_n(&done, true, __ATOMIC_RELEASE);
+    writer.join();
+    state.counters["resizes"] = resizes;
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_concurrent_read_resizing)->Name("geoseq_flatmap56_concurrent_read_resizing")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {1, 2, 4, 8}})->Unit(benchmark::kNanosecond)->UseRealTime();
+
+
+// threads counting the occurrences of keys drawn from a small hot set into one shared concurrent
+// map; every addition to an existing key is a lock-free atomic update
+static void geoseq_flatmap56_fetch_add(benchmark::State& state) {
+    size_t range = state.range(0);
+    size_t nthreads = state.range(1);
+    std::vector<std::thread> threads;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(uint64_t),FLATMAP56_CONCURRENT,NULL);
+    for (auto _ : state){
+        for(size_t t = 0; t < nthreads; t++){
+            threads.emplace_back([map, range, nthreads, t]{
+                for(size_t i = t * range / nthreads; i < (t + 1) * range / nthreads; i++)
+                    flatmap56_fetch_add_u64(map, myarray[i % 1024], 1, NULL);
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        threads.clear();
+    }
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_fetch_add)->Name("geoseq_flatmap56_fetch_add")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {1, 2, 4, 8}})->Unit(benchmark::kNanosecond)->UseRealTime();
+
+
+// fills a new sharded map every iteration from several threads, each inserting its own slice of
+// the keys; the second argument is the number of threads and the third the number of shard bits
+static void geoseq_flatmap56_sharded_insert(benchmark::State& state) {
+    size_t range = state.range(0);
+    size_t nthreads = state.range(1);
+    flatmap56_sharded_t* map = NULL;
+    std::vector<std::thread> threads;
+    for (auto _ : state){
+        state.PauseTiming();
+        flatmap56_sharded_destroy(map);
+        map = flatmap56_sharded_create(state.range(2), 0, sizeof(int), 0, NULL);
+        state.ResumeTiming();
+        for(size_t t = 0; t < nthreads; t++){
+            threads.emplace_back([map, range, nthreads, t]{
+                for(size_t i = t * range / nthreads; i < (t + 1) * range / nthreads; i++)
+                    flatmap56_sharded_insert(map, myarray[i], &myarray[i]);
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        threads.clear();
+    }
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_sharded_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_sharded_insert)->Name("geoseq_flatmap56_sharded_insert")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {1, 2, 4, 8}, {0, 6}})->Unit(benchmark::kNanosecond)->UseRealTime();
+
+static void geoseq_combiner_add(void* value, const void* incoming, void* ctx) {
+    *(int*)value += *(const int*)incoming;
+}
+
+// counts a quarter of the keys, each seen four times, into a new map every iteration from several
+// threads through private buffers of 1024 keys; the second argument is the number of threads
+static void geoseq_flatmap56_combiner_insert(benchmark::State& state) {
+    size_t range = state.range(0);
+    size_t nthreads = state.range(1);
+    flatmap56_t* map = NULL;
+    flatmap56_combiner_t* combiner = NULL;
+    std::vector<std::thread> threads;
+    uint64_t combines = 0;
+    for (auto _ : state){
+        state.PauseTiming();
+        flatmap56_combiner_destroy(combiner);
+        flatmap56_destroy(map);
+        map = flatmap56_create(0, sizeof(int));
+        combiner = flatmap56_combiner_create(map, geoseq_combiner_add, NULL);
+        state.ResumeTiming();
+        for(size_t t = 0; t < nthreads; t++){
+            threads.emplace_back([combiner, range, nthreads, t]{
+                flatmap56_buffer_t* buffer = flatmap56_buffer_create(combiner, 1024);
+                int one = 1;
+                for(size_t i = t * range / nthreads; i < (t + 1) * range / nthreads; i++)
+                    flatmap56_buffer_insert(buffer, myarray[i % (range / 4)], &one);
+                flatmap56_buffer_destroy(buffer);
+            });
+        }
+        for(auto& thread : threads) thread.join();
+        threads.clear();
+        flatmap56_combiner_sync(combiner);
+        combines += flatmap56_combiner_combines(combiner);
+    }
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["locks_per_entry"] = (double)combines / (double)(range * state.iterations());
+    flatmap56_combiner_destroy(combiner);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_combiner_insert)->Name("geoseq_flatmap56_combiner_insert")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {1, 2, 4, 8}})->Unit(benchmark::kNanosecond)->UseRealTime();
+
+
+static void geoseq_flatmap56_lookup_batch(benchmark::State& state) {
+    size_t range = state.range(0);
+    int *value;
+    flatmap56_t* map = flatmap56_create(0,sizeof(int));
+    for(size_t i = 0; i < range; i++){
+        value = (int*)flatmap56_insert(map, myarray[i]);
+        *value = myarray[i];
+    }
+    for (auto _ : state){
+        flatmap56_lookup_batch(map, mykeys, range, myvalues);
+        benchmark::DoNotOptimize(myvalues);
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_lookup_batch)->Name("geoseq_flatmap56_lookup_batch")->DenseRange(10000, MAX_COUNT, 25000)->Unit(benchmark::kNanosecond);
+
+// looks up only the keys that are not in their home bucket, one by one (0) or as a batch (1), so
+// every lookup follows its chain and the batch keeps several chain walks in flight
+static void geoseq_flatmap56_lookup_chained(benchmark::State& state) {
+    size_t range = state.range(0);
+    size_t n = 0;
+    int *value;
+    flatmap56_t* map = flatmap56_create(0,sizeof(int));
+    for(size_t i = 0; i < range; i++){
+        value = (int*)flatmap56_insert(map, myarray[i]);
+        *value = myarray[i];
+    }
+    std::vector<uint64_t> keys;
+    for(size_t i = 0; i < range; i++){
+        if(flatmap56_lookup(map, myarray[i]) != FLATMAP56_VALUE_AT(map,FLATMAP56_HASH(map,(uint64_t)myarray[i]),map->value_stride)) keys.push_back(myarray[i]);
+    }
+    n = keys.size();
+    for (auto _ : state){
+        if(state.range(1)) flatmap56_lookup_batch(map, keys.data(), n, myvalues);
+        else for(size_t i = 0; i < n; i++) myvalues[i] = flatmap56_lookup(map, keys[i]);
+        benchmark::DoNotOptimize(myvalues);
+    }
+    state.counters["chained"] = (double)n / (double)range;
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(n * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_lookup_chained)->Name("geoseq_flatmap56_lookup_chained")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {0, 1}})->Unit(benchmark::kNanosecond);
+
+
 
 static void geoseq_flatmap56_remove(benchmark::State& state) {
     size_t range = state.range(0);
@@ -72,6 +455,90 @@ static void geoseq_flatmap56_remove(benchmark::State& state) {
 BENCHMARK(geoseq_flatmap56_remove)->Name("geoseq_flatmap56_remove")->DenseRange(10000, MAX_COUNT, 25000)->Unit(benchmark::kNanosecond);
 
 
+// refills the table before every iteration and then removes every key; the second argument selects
+// flatmap56_remove() in a loop (0) or a single flatmap56_remove_batch() (1)
+static void geoseq_flatmap56_remove_batch(benchmark::State& state) {
+    size_t range = state.range(0);
+    int removed_value;
+    flatmap56_t* map = flatmap56_create(0,sizeof(int));
+    for (auto _ : state){
+        state.PauseTiming();
+        flatmap56_build(map, mykeys, myarray, range, 1);
+        state.ResumeTiming();
+        if(state.range(1)){
+            benchmark::DoNotOptimize(flatmap56_remove_batch(map, mykeys, range, myremoved));
+        }
+        else{
+            for(size_t i = 0; i < range; i++)
+                benchmark::DoNotOptimize(flatmap56_remove(map, myarray[i], &removed_value));
+        }
+    }
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_remove_batch)->Name("geoseq_flatmap56_remove_batch")->ArgsProduct({benchmark::CreateDenseRange(10000, MAX_COUNT, 25000), {0, 1}})->Unit(benchmark::kNanosecond);
+
+
+
+static void geoseq_flatmap56_int_insert(benchmark::State& state) {
+    size_t range = state.range(0);
+    int *value;
+    flatmap56_t* map = flatmap56_int_create(0);
+    for (auto _ : state){
+        for(size_t i = 0; i < range; i++){
+            value = flatmap56_int_insert(map, myarray[i]);
+            *value = myarray[i];
+        }
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_int_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_int_insert)->Name("geoseq_flatmap56_int_insert")->DenseRange(10000, MAX_COUNT, 25000)->Unit(benchmark::kNanosecond);
+
+
+static void geoseq_flatmap56_int_lookup(benchmark::State& state) {
+    size_t range = state.range(0);
+    int *value;
+    flatmap56_t* map = flatmap56_int_create(0);
+    for(size_t i = 0; i < range; i++){
+        value = flatmap56_int_insert(map, myarray[i]);
+        *value = myarray[i];
+    }
+    for (auto _ : state){
+        for(size_t i = 0; i < range; i++)
+            benchmark::DoNotOptimize(flatmap56_int_lookup(map, myarray[i]));
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_int_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_int_lookup)->Name("geoseq_flatmap56_int_lookup")->DenseRange(10000, MAX_COUNT, 25000)->Unit(benchmark::kNanosecond);
+
+
+static void geoseq_flatmap56_int_remove(benchmark::State& state) {
+    size_t range = state.range(0);
+    int removed_value,*value;
+    flatmap56_t* map = flatmap56_int_create(0);
+    for(size_t i = 0; i < range; i++){
+        value = flatmap56_int_insert(map, myarray[i]);
+        *value = myarray[i];
+    }
+    state.counters["load_factor"] = flatmap56_load_factor(map);
+    for (auto _ : state){
+        for(size_t i = 0; i < range; i++)
+            benchmark::DoNotOptimize(flatmap56_int_remove(map, myarray[i], &removed_value));
+    }
+    state.counters["ns_per_entry"] = benchmark::Counter((double)(range * state.iterations()) / (double)1000000000.0, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    flatmap56_int_destroy(map);
+}
+
+BENCHMARK(geoseq_flatmap56_int_remove)->Name("geoseq_flatmap56_int_remove")->DenseRange(10000, MAX_COUNT, 25000)->Unit(benchmark::kNanosecond);
+
+
 
 static void ska_bytell_lookup(benchmark::State& state) {
     size_t range = state.range(0);
@@ -122,6 +589,7 @@ int main(int argc, char** argv) {
     // other initialization code goes here
     srand(time(0));
     for(size_t i = 0; i < MAX_COUNT; i++) myarray[i] = rand();
+    for(size_t i = 0; i < MAX_COUNT; i++) mykeys[i] = myarray[i];
 
     ::benchmark::Initialize(&argc, argv); 
     if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1; 
@@ -0,0 +1,1061 @@
+//          Copyright Christopher Smith 2022.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// This file is generated by probe_table_generator.py. Do not edit it by hand.
+
+#ifndef _GEOSEQ_PROBE_TABLES_H_
+#define _GEOSEQ_PROBE_TABLES_H_
+
+#define MIN_TABLE_BITS      7
+#define NUM_PROBE_TABLES    58
+
+static const uint64_t probe_tables[NUM_PROBE_TABLES][MAX_PROBES] = {
+    { // 2^7 buckets, common ratio 1.007936
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 15ul,
+        16ul, 17ul, 18ul, 19ul, 20ul, 21ul, 22ul, 23ul,
+        24ul, 25ul, 26ul, 27ul, 28ul, 29ul, 30ul, 31ul,
+        32ul, 33ul, 34ul, 35ul, 36ul, 37ul, 38ul, 39ul,
+        40ul, 41ul, 42ul, 43ul, 44ul, 45ul, 46ul, 47ul,
+        48ul, 49ul, 50ul, 51ul, 52ul, 53ul, 54ul, 55ul,
+        56ul, 57ul, 58ul, 59ul, 60ul, 61ul, 62ul, 63ul,
+        64ul, 65ul, 66ul, 67ul, 68ul, 69ul, 70ul, 71ul,
+        72ul, 73ul, 74ul, 75ul, 76ul, 77ul, 78ul, 79ul,
+        80ul, 81ul, 82ul, 83ul, 84ul, 85ul, 86ul, 87ul,
+        88ul, 89ul, 90ul, 91ul, 92ul, 93ul, 94ul, 95ul,
+        96ul, 97ul, 98ul, 99ul, 100ul, 101ul, 102ul, 103ul,
+        104ul, 105ul, 106ul, 107ul, 108ul, 109ul, 110ul, 111ul,
+        112ul, 113ul, 114ul, 115ul, 116ul, 117ul, 118ul, 119ul,
+        120ul, 121ul, 122ul, 123ul, 124ul, 125ul, 126ul, 0ul
+    },
+    { // 2^8 buckets, common ratio 1.017045
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 15ul,
+        16ul, 17ul, 18ul, 19ul, 20ul, 21ul, 22ul, 23ul,
+        24ul, 25ul, 26ul, 27ul, 28ul, 29ul, 30ul, 31ul,
+        32ul, 33ul, 34ul, 35ul, 36ul, 37ul, 38ul, 39ul,
+        40ul, 41ul, 42ul, 43ul, 44ul, 45ul, 46ul, 47ul,
+        48ul, 49ul, 50ul, 51ul, 52ul, 53ul, 54ul, 55ul,
+        56ul, 57ul, 58ul, 59ul, 61ul, 63ul, 65ul, 67ul,
+        69ul, 71ul, 73ul, 75ul, 77ul, 79ul, 81ul, 83ul,
+        85ul, 87ul, 89ul, 91ul, 93ul, 95ul, 97ul, 99ul,
+        101ul, 103ul, 105ul, 107ul, 109ul, 111ul, 113ul, 115ul,
+        117ul, 119ul, 122ul, 125ul, 128ul, 131ul, 134ul, 137ul,
+        140ul, 143ul, 146ul, 149ul, 152ul, 155ul, 158ul, 161ul,
+        164ul, 167ul, 170ul, 173ul, 176ul, 179ul, 183ul, 187ul,
+        191ul, 195ul, 199ul, 203ul, 207ul, 211ul, 215ul, 219ul,
+        223ul, 227ul, 231ul, 235ul, 240ul, 245ul, 250ul, 0ul
+    },
+    { // 2^9 buckets, common ratio 1.02521
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 15ul,
+        16ul, 17ul, 18ul, 19ul, 20ul, 21ul, 22ul, 23ul,
+        24ul, 25ul, 26ul, 27ul, 28ul, 29ul, 30ul, 31ul,
+        32ul, 33ul, 34ul, 35ul, 36ul, 37ul, 38ul, 39ul,
+        40ul, 42ul, 44ul, 46ul, 48ul, 50ul, 52ul, 54ul,
+        56ul, 58ul, 60ul, 62ul, 64ul, 66ul, 68ul, 70ul,
+        72ul, 74ul, 76ul, 78ul, 80ul, 83ul, 86ul, 89ul,
+        92ul, 95ul, 98ul, 101ul, 104ul, 107ul, 110ul, 113ul,
+        116ul, 119ul, 122ul, 126ul, 130ul, 134ul, 138ul, 142ul,
+        146ul, 150ul, 154ul, 158ul, 162ul, 167ul, 172ul, 177ul,
+        182ul, 187ul, 192ul, 197ul, 202ul, 208ul, 214ul, 220ul,
+        226ul, 232ul, 238ul, 244ul, 251ul, 258ul, 265ul, 272ul,
+        279ul, 287ul, 295ul, 303ul, 311ul, 319ul, 328ul, 337ul,
+        346ul, 355ul, 364ul, 374ul, 384ul, 394ul, 404ul, 415ul,
+        426ul, 437ul, 449ul, 461ul, 473ul, 485ul, 498ul, 0ul
+    },
+    { // 2^10 buckets, common ratio 1.032786
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 15ul,
+        16ul, 17ul, 18ul, 19ul, 20ul, 21ul, 22ul, 23ul,
+        24ul, 25ul, 26ul, 27ul, 28ul, 29ul, 30ul, 31ul,
+        33ul, 35ul, 37ul, 39ul, 41ul, 43ul, 45ul, 47ul,
+        49ul, 51ul, 53ul, 55ul, 57ul, 59ul, 61ul, 63ul,
+        66ul, 69ul, 72ul, 75ul, 78ul, 81ul, 84ul, 87ul,
+        90ul, 93ul, 97ul, 101ul, 105ul, 109ul, 113ul, 117ul,
+        121ul, 125ul, 130ul, 135ul, 140ul, 145ul, 150ul, 155ul,
+        161ul, 167ul, 173ul, 179ul, 185ul, 192ul, 199ul, 206ul,
+        213ul, 220ul, 228ul, 236ul, 244ul, 252ul, 261ul, 270ul,
+        279ul, 289ul, 299ul, 309ul, 320ul, 331ul, 342ul, 354ul,
+        366ul, 378ul, 391ul, 404ul, 418ul, 432ul, 447ul, 462ul,
+        478ul, 494ul, 511ul, 528ul, 546ul, 564ul, 583ul, 603ul,
+        623ul, 644ul, 666ul, 688ul, 711ul, 735ul, 760ul, 785ul,
+        811ul, 838ul, 866ul, 895ul, 925ul, 956ul, 988ul, 0ul
+    },
+    { // 2^11 buckets, common ratio 1.04
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 15ul,
+        16ul, 17ul, 18ul, 19ul, 20ul, 21ul, 22ul, 23ul,
+        24ul, 25ul, 26ul, 28ul, 30ul, 32ul, 34ul, 36ul,
+        38ul, 40ul, 42ul, 44ul, 46ul, 48ul, 50ul, 52ul,
+        55ul, 58ul, 61ul, 64ul, 67ul, 70ul, 73ul, 76ul,
+        80ul, 84ul, 88ul, 92ul, 96ul, 100ul, 104ul, 109ul,
+        114ul, 119ul, 124ul, 129ul, 135ul, 141ul, 147ul, 153ul,
+        160ul, 167ul, 174ul, 181ul, 189ul, 197ul, 205ul, 214ul,
+        223ul, 232ul, 242ul, 252ul, 263ul, 274ul, 285ul, 297ul,
+        309ul, 322ul, 335ul, 349ul, 363ul, 378ul, 394ul, 410ul,
+        427ul, 445ul, 463ul, 482ul, 502ul, 523ul, 544ul, 566ul,
+        589ul, 613ul, 638ul, 664ul, 691ul, 719ul, 748ul, 778ul,
+        810ul, 843ul, 877ul, 913ul, 950ul, 988ul, 1028ul, 1070ul,
+        1113ul, 1158ul, 1205ul, 1254ul, 1305ul, 1358ul, 1413ul, 1470ul,
+        1529ul, 1591ul, 1655ul, 1722ul, 1791ul, 1863ul, 1938ul, 0ul
+    },
+    { // 2^12 buckets, common ratio 1.047058
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 15ul,
+        16ul, 17ul, 18ul, 19ul, 20ul, 21ul, 22ul, 24ul,
+        26ul, 28ul, 30ul, 32ul, 34ul, 36ul, 38ul, 40ul,
+        42ul, 44ul, 47ul, 50ul, 53ul, 56ul, 59ul, 62ul,
+        65ul, 69ul, 73ul, 77ul, 81ul, 85ul, 89ul, 94ul,
+        99ul, 104ul, 109ul, 115ul, 121ul, 127ul, 133ul, 140ul,
+        147ul, 154ul, 162ul, 170ul, 178ul, 187ul, 196ul, 206ul,
+        216ul, 227ul, 238ul, 250ul, 262ul, 275ul, 288ul, 302ul,
+        317ul, 332ul, 348ul, 365ul, 383ul, 402ul, 421ul, 441ul,
+        462ul, 484ul, 507ul, 531ul, 556ul, 583ul, 611ul, 640ul,
+        671ul, 703ul, 737ul, 772ul, 809ul, 848ul, 888ul, 930ul,
+        974ul, 1020ul, 1068ul, 1119ul, 1172ul, 1228ul, 1286ul, 1347ul,
+        1411ul, 1478ul, 1548ul, 1621ul, 1698ul, 1778ul, 1862ul, 1950ul,
+        2042ul, 2139ul, 2240ul, 2346ul, 2457ul, 2573ul, 2695ul, 2822ul,
+        2955ul, 3095ul, 3241ul, 3394ul, 3554ul, 3722ul, 3898ul, 0ul
+    },
+    { // 2^13 buckets, common ratio 1.053763
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 15ul,
+        16ul, 17ul, 18ul, 19ul, 21ul, 23ul, 25ul, 27ul,
+        29ul, 31ul, 33ul, 35ul, 37ul, 39ul, 42ul, 45ul,
+        48ul, 51ul, 54ul, 57ul, 61ul, 65ul, 69ul, 73ul,
+        77ul, 82ul, 87ul, 92ul, 97ul, 103ul, 109ul, 115ul,
+        122ul, 129ul, 136ul, 144ul, 152ul, 161ul, 170ul, 180ul,
+        190ul, 201ul, 212ul, 224ul, 237ul, 250ul, 264ul, 279ul,
+        294ul, 310ul, 327ul, 345ul, 364ul, 384ul, 405ul, 427ul,
+        450ul, 475ul, 501ul, 528ul, 557ul, 587ul, 619ul, 653ul,
+        689ul, 727ul, 767ul, 809ul, 853ul, 899ul, 948ul, 999ul,
+        1053ul, 1110ul, 1170ul, 1233ul, 1300ul, 1370ul, 1444ul, 1522ul,
+        1604ul, 1691ul, 1782ul, 1878ul, 1979ul, 2086ul, 2199ul, 2318ul,
+        2443ul, 2575ul, 2714ul, 2860ul, 3014ul, 3177ul, 3348ul, 3528ul,
+        3718ul, 3918ul, 4129ul, 4351ul, 4585ul, 4832ul, 5092ul, 5366ul,
+        5655ul, 5960ul, 6281ul, 6619ul, 6975ul, 7350ul, 7746ul, 0ul
+    },
+    { // 2^14 buckets, common ratio 1.060397
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 15ul,
+        16ul, 17ul, 19ul, 21ul, 23ul, 25ul, 27ul, 29ul,
+        31ul, 33ul, 35ul, 38ul, 41ul, 44ul, 47ul, 50ul,
+        54ul, 58ul, 62ul, 66ul, 70ul, 75ul, 80ul, 85ul,
+        91ul, 97ul, 103ul, 110ul, 117ul, 125ul, 133ul, 142ul,
+        151ul, 161ul, 171ul, 182ul, 193ul, 205ul, 218ul, 232ul,
+        247ul, 262ul, 278ul, 295ul, 313ul, 332ul, 353ul, 375ul,
+        398ul, 423ul, 449ul, 477ul, 506ul, 537ul, 570ul, 605ul,
+        642ul, 681ul, 723ul, 767ul, 814ul, 864ul, 917ul, 973ul,
+        1032ul, 1095ul, 1162ul, 1233ul, 1308ul, 1387ul, 1471ul, 1560ul,
+        1655ul, 1755ul, 1861ul, 1974ul, 2094ul, 2221ul, 2356ul, 2499ul,
+        2650ul, 2811ul, 2981ul, 3162ul, 3353ul, 3556ul, 3771ul, 3999ul,
+        4241ul, 4498ul, 4770ul, 5059ul, 5365ul, 5690ul, 6034ul, 6399ul,
+        6786ul, 7196ul, 7631ul, 8092ul, 8581ul, 9100ul, 9650ul, 10233ul,
+        10852ul, 11508ul, 12204ul, 12942ul, 13724ul, 14553ul, 15432ul, 0ul
+    },
+    { // 2^15 buckets, common ratio 1.067061
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 15ul,
+        17ul, 19ul, 21ul, 23ul, 25ul, 27ul, 29ul, 31ul,
+        34ul, 37ul, 40ul, 43ul, 46ul, 50ul, 54ul, 58ul,
+        62ul, 67ul, 72ul, 77ul, 83ul, 89ul, 95ul, 102ul,
+        109ul, 117ul, 125ul, 134ul, 143ul, 153ul, 164ul, 175ul,
+        187ul, 200ul, 214ul, 229ul, 245ul, 262ul, 280ul, 299ul,
+        320ul, 342ul, 365ul, 390ul, 417ul, 445ul, 475ul, 507ul,
+        541ul, 578ul, 617ul, 659ul, 704ul, 752ul, 803ul, 857ul,
+        915ul, 977ul, 1043ul, 1113ul, 1188ul, 1268ul, 1354ul, 1445ul,
+        1542ul, 1646ul, 1757ul, 1875ul, 2001ul, 2136ul, 2280ul, 2433ul,
+        2597ul, 2772ul, 2958ul, 3157ul, 3369ul, 3595ul, 3837ul, 4095ul,
+        4370ul, 4664ul, 4977ul, 5311ul, 5668ul, 6049ul, 6455ul, 6888ul,
+        7350ul, 7843ul, 8369ul, 8931ul, 9530ul, 10170ul, 10853ul, 11581ul,
+        12358ul, 13187ul, 14072ul, 15016ul, 16023ul, 17098ul, 18245ul, 19469ul,
+        20775ul, 22169ul, 23656ul, 25243ul, 26936ul, 28743ul, 30671ul, 0ul
+    },
+    { // 2^16 buckets, common ratio 1.073619
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 14ul, 16ul,
+        18ul, 20ul, 22ul, 24ul, 26ul, 28ul, 31ul, 34ul,
+        37ul, 40ul, 43ul, 47ul, 51ul, 55ul, 60ul, 65ul,
+        70ul, 76ul, 82ul, 89ul, 96ul, 104ul, 112ul, 121ul,
+        130ul, 140ul, 151ul, 163ul, 175ul, 188ul, 202ul, 217ul,
+        233ul, 251ul, 270ul, 290ul, 312ul, 335ul, 360ul, 387ul,
+        416ul, 447ul, 480ul, 516ul, 554ul, 595ul, 639ul, 687ul,
+        738ul, 793ul, 852ul, 915ul, 983ul, 1056ul, 1134ul, 1218ul,
+        1308ul, 1405ul, 1509ul, 1621ul, 1741ul, 1870ul, 2008ul, 2156ul,
+        2315ul, 2486ul, 2670ul, 2867ul, 3079ul, 3306ul, 3550ul, 3812ul,
+        4093ul, 4395ul, 4719ul, 5067ul, 5441ul, 5842ul, 6273ul, 6735ul,
+        7231ul, 7764ul, 8336ul, 8950ul, 9609ul, 10317ul, 11077ul, 11893ul,
+        12769ul, 13710ul, 14720ul, 15804ul, 16968ul, 18218ul, 19560ul, 21000ul,
+        22546ul, 24206ul, 25989ul, 27903ul, 29958ul, 32164ul, 34532ul, 37075ul,
+        39805ul, 42736ul, 45883ul, 49261ul, 52888ul, 56782ul, 60963ul, 0ul
+    },
+    { // 2^17 buckets, common ratio 1.080204
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 13ul, 15ul, 17ul,
+        19ul, 21ul, 23ul, 25ul, 28ul, 31ul, 34ul, 37ul,
+        40ul, 44ul, 48ul, 52ul, 57ul, 62ul, 67ul, 73ul,
+        79ul, 86ul, 93ul, 101ul, 110ul, 119ul, 129ul, 140ul,
+        152ul, 165ul, 179ul, 194ul, 210ul, 227ul, 246ul, 266ul,
+        288ul, 312ul, 338ul, 366ul, 396ul, 428ul, 463ul, 501ul,
+        542ul, 586ul, 633ul, 684ul, 739ul, 799ul, 864ul, 934ul,
+        1009ul, 1090ul, 1178ul, 1273ul, 1376ul, 1487ul, 1607ul, 1736ul,
+        1876ul, 2027ul, 2190ul, 2366ul, 2556ul, 2762ul, 2984ul, 3224ul,
+        3483ul, 3763ul, 4065ul, 4392ul, 4745ul, 5126ul, 5538ul, 5983ul,
+        6463ul, 6982ul, 7542ul, 8147ul, 8801ul, 9507ul, 10270ul, 11094ul,
+        11984ul, 12946ul, 13985ul, 15107ul, 16319ul, 17628ul, 19042ul, 20570ul,
+        22220ul, 24003ul, 25929ul, 28009ul, 30256ul, 32683ul, 35305ul, 38137ul,
+        41196ul, 44501ul, 48071ul, 51927ul, 56092ul, 60591ul, 65451ul, 70701ul,
+        76372ul, 82498ul, 89115ul, 96263ul, 103984ul, 112324ul, 121333ul, 0ul
+    },
+    { // 2^18 buckets, common ratio 1.086687
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 12ul, 14ul, 16ul, 18ul,
+        20ul, 22ul, 24ul, 27ul, 30ul, 33ul, 36ul, 40ul,
+        44ul, 48ul, 53ul, 58ul, 64ul, 70ul, 77ul, 84ul,
+        92ul, 100ul, 109ul, 119ul, 130ul, 142ul, 155ul, 169ul,
+        184ul, 200ul, 218ul, 237ul, 258ul, 281ul, 306ul, 333ul,
+        362ul, 394ul, 429ul, 467ul, 508ul, 553ul, 601ul, 654ul,
+        711ul, 773ul, 841ul, 914ul, 994ul, 1081ul, 1175ul, 1277ul,
+        1388ul, 1509ul, 1640ul, 1783ul, 1938ul, 2106ul, 2289ul, 2488ul,
+        2704ul, 2939ul, 3194ul, 3471ul, 3772ul, 4099ul, 4455ul, 4842ul,
+        5262ul, 5719ul, 6215ul, 6754ul, 7340ul, 7977ul, 8669ul, 9421ul,
+        10238ul, 11126ul, 12091ul, 13140ul, 14280ul, 15518ul, 16864ul, 18326ul,
+        19915ul, 21642ul, 23519ul, 25558ul, 27774ul, 30182ul, 32799ul, 35643ul,
+        38733ul, 42091ul, 45740ul, 49706ul, 54015ul, 58698ul, 63787ul, 69317ul,
+        75326ul, 81856ul, 88952ul, 96663ul, 105043ul, 114149ul, 124045ul, 134799ul,
+        146485ul, 159184ul, 172984ul, 187980ul, 204276ul, 221985ul, 241229ul, 0ul
+    },
+    { // 2^19 buckets, common ratio 1.093513
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 11ul, 13ul, 15ul, 17ul, 19ul,
+        21ul, 23ul, 26ul, 29ul, 32ul, 35ul, 39ul, 43ul,
+        48ul, 53ul, 58ul, 64ul, 70ul, 77ul, 85ul, 93ul,
+        102ul, 112ul, 123ul, 135ul, 148ul, 162ul, 178ul, 195ul,
+        214ul, 235ul, 257ul, 282ul, 309ul, 338ul, 370ul, 405ul,
+        443ul, 485ul, 531ul, 581ul, 636ul, 696ul, 762ul, 834ul,
+        912ul, 998ul, 1092ul, 1195ul, 1307ul, 1430ul, 1564ul, 1711ul,
+        1872ul, 2048ul, 2240ul, 2450ul, 2680ul, 2931ul, 3206ul, 3506ul,
+        3834ul, 4193ul, 4586ul, 5015ul, 5484ul, 5997ul, 6558ul, 7172ul,
+        7843ul, 8577ul, 9380ul, 10258ul, 11218ul, 12268ul, 13416ul, 14671ul,
+        16043ul, 17544ul, 19185ul, 20980ul, 22942ul, 25088ul, 27435ul, 30001ul,
+        32807ul, 35875ul, 39230ul, 42899ul, 46911ul, 51298ul, 56096ul, 61342ul,
+        67079ul, 73352ul, 80212ul, 87713ul, 95916ul, 104886ul, 114695ul, 125421ul,
+        137150ul, 149976ul, 164001ul, 179338ul, 196109ul, 214448ul, 234502ul, 256431ul,
+        280411ul, 306634ul, 335309ul, 366665ul, 400953ul, 438448ul, 479449ul, 0ul
+    },
+    { // 2^20 buckets, common ratio 1.1
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 12ul, 14ul, 16ul, 18ul, 20ul,
+        23ul, 26ul, 29ul, 32ul, 36ul, 40ul, 45ul, 50ul,
+        56ul, 62ul, 69ul, 76ul, 84ul, 93ul, 103ul, 114ul,
+        126ul, 139ul, 153ul, 169ul, 186ul, 205ul, 226ul, 249ul,
+        274ul, 302ul, 333ul, 367ul, 404ul, 445ul, 490ul, 540ul,
+        595ul, 655ul, 721ul, 794ul, 874ul, 962ul, 1059ul, 1165ul,
+        1282ul, 1411ul, 1553ul, 1709ul, 1880ul, 2069ul, 2276ul, 2504ul,
+        2755ul, 3031ul, 3335ul, 3669ul, 4036ul, 4440ul, 4885ul, 5374ul,
+        5912ul, 6504ul, 7155ul, 7871ul, 8659ul, 9525ul, 10478ul, 11526ul,
+        12679ul, 13947ul, 15342ul, 16877ul, 18565ul, 20422ul, 22465ul, 24712ul,
+        27184ul, 29903ul, 32894ul, 36184ul, 39803ul, 43784ul, 48163ul, 52980ul,
+        58279ul, 64107ul, 70518ul, 77570ul, 85328ul, 93861ul, 103248ul, 113573ul,
+        124931ul, 137425ul, 151168ul, 166285ul, 182914ul, 201206ul, 221327ul, 243460ul,
+        267807ul, 294588ul, 324047ul, 356452ul, 392098ul, 431308ul, 474439ul, 521883ul,
+        574072ul, 631480ul, 694629ul, 764092ul, 840502ul, 924553ul, 1017009ul, 0ul
+    },
+    { // 2^21 buckets, common ratio 1.106626
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 10ul, 12ul, 14ul, 16ul, 18ul, 20ul,
+        23ul, 26ul, 29ul, 33ul, 37ul, 41ul, 46ul, 51ul,
+        57ul, 64ul, 71ul, 79ul, 88ul, 98ul, 109ul, 121ul,
+        134ul, 149ul, 165ul, 183ul, 203ul, 225ul, 249ul, 276ul,
+        306ul, 339ul, 376ul, 417ul, 462ul, 512ul, 567ul, 628ul,
+        695ul, 770ul, 853ul, 944ul, 1045ul, 1157ul, 1281ul, 1418ul,
+        1570ul, 1738ul, 1924ul, 2130ul, 2358ul, 2610ul, 2889ul, 3198ul,
+        3539ul, 3917ul, 4335ul, 4798ul, 5310ul, 5877ul, 6504ul, 7198ul,
+        7966ul, 8816ul, 9757ul, 10798ul, 11950ul, 13225ul, 14636ul, 16197ul,
+        17925ul, 19837ul, 21953ul, 24294ul, 26885ul, 29752ul, 32925ul, 36436ul,
+        40322ul, 44622ul, 49380ul, 54646ul, 60473ul, 66921ul, 74057ul, 81954ul,
+        90693ul, 100364ul, 111066ul, 122909ul, 136015ul, 150518ul, 166568ul, 184329ul,
+        203984ul, 225735ul, 249805ul, 276441ul, 305917ul, 338536ul, 374633ul, 414579ul,
+        458784ul, 507703ul, 561838ul, 621745ul, 688040ul, 761403ul, 842589ul, 932431ul,
+        1031853ul, 1141876ul, 1263630ul, 1398366ul, 1547469ul, 1712470ul, 1895064ul, 0ul
+    },
+    { // 2^22 buckets, common ratio 1.112655
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 11ul, 13ul, 15ul, 17ul, 19ul, 22ul,
+        25ul, 28ul, 32ul, 36ul, 41ul, 46ul, 52ul, 58ul,
+        65ul, 73ul, 82ul, 92ul, 103ul, 115ul, 128ul, 143ul,
+        160ul, 179ul, 200ul, 223ul, 249ul, 278ul, 310ul, 345ul,
+        384ul, 428ul, 477ul, 531ul, 591ul, 658ul, 733ul, 816ul,
+        908ul, 1011ul, 1125ul, 1252ul, 1394ul, 1552ul, 1727ul, 1922ul,
+        2139ul, 2380ul, 2649ul, 2948ul, 3281ul, 3651ul, 4063ul, 4521ul,
+        5031ul, 5598ul, 6229ul, 6931ul, 7712ul, 8581ul, 9548ul, 10624ul,
+        11821ul, 13153ul, 14635ul, 16284ul, 18119ul, 20161ul, 22433ul, 24961ul,
+        27773ul, 30902ul, 34384ul, 38258ul, 42568ul, 47364ul, 52700ul, 58637ul,
+        65243ul, 72593ul, 80771ul, 89871ul, 99996ul, 111262ul, 123797ul, 137744ul,
+        153262ul, 170528ul, 189739ul, 211115ul, 234899ul, 261362ul, 290806ul, 323567ul,
+        360019ul, 400577ul, 445705ul, 495916ul, 551784ul, 613946ul, 683111ul, 760067ul,
+        845693ul, 940965ul, 1046970ul, 1164917ul, 1296151ul, 1442169ul, 1604637ul, 1785408ul,
+        1986544ul, 2210339ul, 2459345ul, 2736403ul, 3044673ul, 3387671ul, 3769310ul, 0ul
+    },
+    { // 2^23 buckets, common ratio 1.119395
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 9ul, 11ul, 13ul, 15ul, 17ul, 20ul, 23ul,
+        26ul, 30ul, 34ul, 39ul, 44ul, 50ul, 56ul, 63ul,
+        71ul, 80ul, 90ul, 101ul, 114ul, 128ul, 144ul, 162ul,
+        182ul, 204ul, 229ul, 257ul, 288ul, 323ul, 362ul, 406ul,
+        455ul, 510ul, 571ul, 640ul, 717ul, 803ul, 899ul, 1007ul,
+        1128ul, 1263ul, 1414ul, 1583ul, 1773ul, 1985ul, 2222ul, 2488ul,
+        2786ul, 3119ul, 3492ul, 3909ul, 4376ul, 4899ul, 5484ul, 6139ul,
+        6872ul, 7693ul, 8612ul, 9641ul, 10793ul, 12082ul, 13525ul, 15140ul,
+        16948ul, 18972ul, 21238ul, 23774ul, 26613ul, 29791ul, 33348ul, 37330ul,
+        41788ul, 46778ul, 52364ul, 58617ul, 65616ul, 73451ul, 82221ul, 92038ul,
+        103027ul, 115328ul, 129098ul, 144512ul, 161767ul, 181082ul, 202703ul, 226905ul,
+        253997ul, 284323ul, 318270ul, 356270ul, 398807ul, 446423ul, 499724ul, 559389ul,
+        626178ul, 700941ul, 784630ul, 878311ul, 983177ul, 1100564ul, 1231966ul, 1379057ul,
+        1543710ul, 1728022ul, 1934340ul, 2165291ul, 2423816ul, 2713208ul, 3037152ul, 3399773ul,
+        3805689ul, 4260070ul, 4768702ul, 5338062ul, 5975401ul, 6688835ul, 7487449ul, 0ul
+    },
+    { // 2^24 buckets, common ratio 1.125382
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 10ul, 12ul, 14ul, 16ul, 19ul, 22ul, 25ul,
+        29ul, 33ul, 38ul, 43ul, 49ul, 56ul, 64ul, 73ul,
+        83ul, 94ul, 106ul, 120ul, 136ul, 154ul, 174ul, 196ul,
+        221ul, 249ul, 281ul, 317ul, 357ul, 402ul, 453ul, 510ul,
+        574ul, 646ul, 727ul, 819ul, 922ul, 1038ul, 1169ul, 1316ul,
+        1482ul, 1668ul, 1878ul, 2114ul, 2380ul, 2679ul, 3015ul, 3394ul,
+        3820ul, 4299ul, 4839ul, 5446ul, 6129ul, 6898ul, 7763ul, 8737ul,
+        9833ul, 11066ul, 12454ul, 14016ul, 15774ul, 17752ul, 19978ul, 22483ul,
+        25302ul, 28475ul, 32046ul, 36064ul, 40586ul, 45675ul, 51402ul, 57847ul,
+        65100ul, 73263ul, 82449ul, 92787ul, 104421ul, 117514ul, 132249ul, 148831ul,
+        167492ul, 188493ul, 212127ul, 238724ul, 268656ul, 302341ul, 340250ul, 382912ul,
+        430923ul, 484953ul, 545758ul, 614187ul, 691195ul, 777859ul, 875389ul, 985147ul,
+        1108667ul, 1247674ul, 1404110ul, 1580161ul, 1778285ul, 2001250ul, 2252171ul, 2534553ul,
+        2852341ul, 3209974ul, 3612447ul, 4065383ul, 4575109ul, 5148746ul, 5794306ul, 6520808ul,
+        7338400ul, 8258503ul, 9293971ul, 10459268ul, 11770672ul, 13246502ul, 14907375ul, 0ul
+    },
+    { // 2^25 buckets, common ratio 1.132877
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 10ul, 12ul, 14ul, 16ul, 19ul, 22ul, 25ul,
+        29ul, 33ul, 38ul, 44ul, 50ul, 57ul, 65ul, 74ul,
+        84ul, 96ul, 109ul, 124ul, 141ul, 160ul, 182ul, 207ul,
+        235ul, 267ul, 303ul, 344ul, 390ul, 442ul, 501ul, 568ul,
+        644ul, 730ul, 828ul, 939ul, 1064ul, 1206ul, 1367ul, 1549ul,
+        1755ul, 1989ul, 2254ul, 2554ul, 2894ul, 3279ul, 3715ul, 4209ul,
+        4769ul, 5403ul, 6121ul, 6935ul, 7857ul, 8902ul, 10085ul, 11426ul,
+        12945ul, 14666ul, 16615ul, 18823ul, 21325ul, 24159ul, 27370ul, 31007ul,
+        35128ul, 39796ul, 45084ul, 51075ul, 57862ul, 65551ul, 74262ul, 84130ul,
+        95309ul, 107974ul, 122322ul, 138576ul, 156990ul, 177851ul, 201484ul, 228257ul,
+        258588ul, 292949ul, 331876ul, 375975ul, 425934ul, 482531ul, 546649ul, 619287ul,
+        701576ul, 794800ul, 900411ul, 1020055ul, 1155597ul, 1309150ul, 1483106ul, 1680177ul,
+        1903434ul, 2156357ul, 2442888ul, 2767492ul, 3135229ul, 3551829ul, 4023786ul, 4558455ul,
+        5164169ul, 5850369ul, 6627749ul, 7508425ul, 8506122ul, 9636390ul, 10916845ul, 12367443ul,
+        14010792ul, 15872504ul, 17981595ul, 20370936ul, 23077765ul, 26144270ul, 29618242ul, 0ul
+    },
+    { // 2^26 buckets, common ratio 1.139668
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        8ul, 10ul, 12ul, 14ul, 16ul, 19ul, 22ul, 26ul,
+        30ul, 35ul, 40ul, 46ul, 53ul, 61ul, 70ul, 80ul,
+        92ul, 105ul, 120ul, 137ul, 157ul, 179ul, 205ul, 234ul,
+        267ul, 305ul, 348ul, 397ul, 453ul, 517ul, 590ul, 673ul,
+        767ul, 875ul, 998ul, 1138ul, 1297ul, 1479ul, 1686ul, 1922ul,
+        2191ul, 2498ul, 2847ul, 3245ul, 3699ul, 4216ul, 4805ul, 5477ul,
+        6242ul, 7114ul, 8108ul, 9241ul, 10532ul, 12003ul, 13680ul, 15591ul,
+        17769ul, 20251ul, 23080ul, 26304ul, 29978ul, 34165ul, 38937ul, 44376ul,
+        50574ul, 57638ul, 65689ul, 74864ul, 85321ul, 97238ul, 110820ul, 126299ul,
+        143939ul, 164043ul, 186955ul, 213067ul, 242826ul, 276742ul, 315394ul, 359445ul,
+        409648ul, 466863ul, 532069ul, 606383ul, 691076ul, 787598ul, 897601ul, 1022968ul,
+        1165844ul, 1328676ul, 1514250ul, 1725743ul, 1966775ul, 2241471ul, 2554533ul, 2911320ul,
+        3317939ul, 3781349ul, 4309483ul, 4911380ul, 5597343ul, 6379113ul, 7270071ul, 8285468ul,
+        9442683ul, 10761524ul, 12264565ul, 13977533ul, 15929747ul, 18154623ul, 20690243ul, 23580008ul,
+        26873381ul, 30626733ul, 34904308ul, 39779323ul, 45335222ul, 51667102ul, 58883343ul, 0ul
+    },
+    { // 2^27 buckets, common ratio 1.145878
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        9ul, 11ul, 13ul, 15ul, 18ul, 21ul, 25ul, 29ul,
+        34ul, 39ul, 45ul, 52ul, 60ul, 69ul, 80ul, 92ul,
+        106ul, 122ul, 140ul, 161ul, 185ul, 212ul, 243ul, 279ul,
+        320ul, 367ul, 421ul, 483ul, 554ul, 635ul, 728ul, 835ul,
+        957ul, 1097ul, 1258ul, 1442ul, 1653ul, 1895ul, 2172ul, 2489ul,
+        2853ul, 3270ul, 3748ul, 4295ul, 4922ul, 5641ul, 6464ul, 7407ul,
+        8488ul, 9727ul, 11146ul, 12772ul, 14636ul, 16772ul, 19219ul, 22023ul,
+        25236ul, 28918ul, 33137ul, 37971ul, 43511ul, 49859ul, 57133ul, 65468ul,
+        75019ul, 85963ul, 98504ul, 112874ul, 129340ul, 148208ul, 169829ul, 194604ul,
+        222993ul, 255523ul, 292799ul, 335512ul, 384456ul, 440540ul, 504806ul, 578447ul,
+        662830ul, 759523ul, 870321ul, 997282ul, 1142764ul, 1309469ul, 1500492ul, 1719381ul,
+        1970201ul, 2257610ul, 2586946ul, 2964325ul, 3396755ul, 3892267ul, 4460063ul, 5110688ul,
+        5856225ul, 6710520ul, 7689437ul, 8811157ul, 10096511ul, 11569370ul, 13257087ul, 15191004ul,
+        17407037ul, 19946341ul, 22856073ul, 26190271ul, 30010855ul, 34388778ul, 39405343ul, 45153714ul,
+        51740646ul, 59288466ul, 67937347ul, 77847909ul, 89204203ul, 102217130ul, 117128357ul, 0ul
+    },
+    { // 2^28 buckets, common ratio 1.152606
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        9ul, 11ul, 13ul, 15ul, 18ul, 21ul, 25ul, 29ul,
+        34ul, 40ul, 47ul, 55ul, 64ul, 74ul, 86ul, 100ul,
+        116ul, 134ul, 155ul, 179ul, 207ul, 239ul, 276ul, 319ul,
+        368ul, 425ul, 490ul, 565ul, 652ul, 752ul, 867ul, 1000ul,
+        1153ul, 1329ul, 1532ul, 1766ul, 2036ul, 2347ul, 2706ul, 3119ul,
+        3595ul, 4144ul, 4777ul, 5506ul, 6347ul, 7316ul, 8433ul, 9720ul,
+        11204ul, 12914ul, 14885ul, 17157ul, 19776ul, 22794ul, 26273ul, 30283ul,
+        34905ul, 40232ul, 46372ul, 53449ul, 61606ul, 71008ul, 81845ul, 94336ul,
+        108733ul, 125327ul, 144453ul, 166498ul, 191907ul, 221194ul, 254950ul, 293857ul,
+        338702ul, 390390ul, 449966ul, 518634ul, 597781ul, 689006ul, 794153ul, 915346ul,
+        1055034ul, 1216039ul, 1401614ul, 1615509ul, 1862046ul, 2146206ul, 2473730ul, 2851237ul,
+        3286353ul, 3787871ul, 4365923ul, 5032190ul, 5800133ul, 6685269ul, 7705482ul, 8881385ul,
+        10236738ul, 11798926ul, 13599514ul, 15674882ul, 18066964ul, 20824092ul, 24001974ul, 27664820ul,
+        31886638ul, 36752731ul, 42361419ul, 48826027ul, 56277173ul, 64865408ul, 74764260ul, 86173736ul,
+        99324367ul, 114481863ul, 131952484ul, 152089227ul, 175298958ul, 202050633ul, 232884775ul, 0ul
+    },
+    { // 2^29 buckets, common ratio 1.158852
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        9ul, 11ul, 13ul, 16ul, 19ul, 23ul, 27ul, 32ul,
+        38ul, 45ul, 53ul, 62ul, 72ul, 84ul, 98ul, 114ul,
+        133ul, 155ul, 180ul, 209ul, 243ul, 282ul, 327ul, 379ul,
+        440ul, 510ul, 592ul, 687ul, 797ul, 924ul, 1071ul, 1242ul,
+        1440ul, 1669ul, 1935ul, 2243ul, 2600ul, 3014ul, 3493ul, 4048ul,
+        4692ul, 5438ul, 6302ul, 7304ul, 8465ul, 9810ul, 11369ul, 13175ul,
+        15268ul, 17694ul, 20505ul, 23763ul, 27538ul, 31913ul, 36983ul, 42858ul,
+        49667ul, 57557ul, 66701ul, 77297ul, 89576ul, 103806ul, 120296ul, 139406ul,
+        161551ul, 187214ul, 216954ul, 251418ul, 291357ul, 337640ul, 391275ul, 453430ul,
+        525459ul, 608930ul, 705660ul, 817756ul, 947659ul, 1098197ul, 1272648ul, 1474811ul,
+        1709088ul, 1980581ul, 2295201ul, 2659799ul, 3082314ul, 3571946ul, 4139357ul, 4796903ul,
+        5558901ul, 6441944ul, 7465260ul, 8651132ul, 10025382ul, 11617934ul, 13463466ul, 15602165ul,
+        18080600ul, 20952740ul, 24281125ul, 28138230ul, 32608044ul, 37787897ul, 43790580ul, 50746801ul,
+        58808031ul, 68149804ul, 78975536ul, 91520957ul, 106059243ul, 122906964ul, 142430979ul, 165056423ul,
+        191275963ul, 221660529ul, 256871744ul, 297676330ul, 344962805ul, 399760831ul, 463263631ul, 0ul
+    },
+    { // 2^30 buckets, common ratio 1.166347
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 7ul,
+        9ul, 11ul, 13ul, 16ul, 19ul, 23ul, 27ul, 32ul,
+        38ul, 45ul, 53ul, 62ul, 73ul, 86ul, 101ul, 118ul,
+        138ul, 161ul, 188ul, 220ul, 257ul, 300ul, 350ul, 409ul,
+        478ul, 558ul, 651ul, 760ul, 887ul, 1035ul, 1208ul, 1409ul,
+        1644ul, 1918ul, 2238ul, 2611ul, 3046ul, 3553ul, 4145ul, 4835ul,
+        5640ul, 6579ul, 7674ul, 8951ul, 10440ul, 12177ul, 14203ul, 16566ul,
+        19322ul, 22537ul, 26286ul, 30659ul, 35760ul, 41709ul, 48648ul, 56741ul,
+        66180ul, 77189ul, 90030ul, 105007ul, 122475ul, 142849ul, 166612ul, 194328ul,
+        226654ul, 264358ul, 308334ul, 359625ul, 419448ul, 489222ul, 570603ul, 665522ul,
+        776230ul, 905354ul, 1055957ul, 1231613ul, 1436489ul, 1675445ul, 1954151ul, 2279219ul,
+        2658361ul, 3100572ul, 3616343ul, 4217911ul, 4919548ul, 5737901ul, 6692384ul, 7805643ul,
+        9104089ul, 10618528ul, 12384889ul, 14445079ul, 16847975ul, 19650586ul, 22919403ul, 26731978ul,
+        31178764ul, 36365259ul, 42414512ul, 49470040ul, 57699235ul, 67297332ul, 78492044ul, 91548963ul,
+        106777861ul, 124540041ul, 145256907ul, 169419962ul, 197602469ul, 230473053ul, 268811561ul, 313527565ul,
+        365681944ul, 426512049ul, 497461061ul, 580212230ul, 676728810ul, 789300636ul, 920598451ul, 0ul
+    },
+    { // 2^31 buckets, common ratio 1.172321
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 8ul,
+        10ul, 12ul, 15ul, 18ul, 22ul, 26ul, 31ul, 37ul,
+        44ul, 52ul, 61ul, 72ul, 85ul, 100ul, 118ul, 139ul,
+        163ul, 192ul, 226ul, 265ul, 311ul, 365ul, 428ul, 502ul,
+        589ul, 691ul, 811ul, 951ul, 1115ul, 1308ul, 1534ul, 1799ul,
+        2110ul, 2474ul, 2901ul, 3401ul, 3988ul, 4676ul, 5482ul, 6427ul,
+        7535ul, 8834ul, 10357ul, 12142ul, 14235ul, 16688ul, 19564ul, 22936ul,
+        26889ul, 31523ul, 36956ul, 43325ul, 50791ul, 59544ul, 69805ul, 81834ul,
+        95936ul, 112468ul, 131849ul, 154570ul, 181206ul, 212432ul, 249039ul, 291954ul,
+        342264ul, 401244ul, 470387ul, 551445ul, 646471ul, 757872ul, 888470ul, 1041573ul,
+        1221058ul, 1431472ul, 1678145ul, 1967325ul, 2306337ul, 2703768ul, 3169684ul, 3715887ul,
+        4356213ul, 5106880ul, 5986903ul, 7018572ul, 8228020ul, 9645881ul, 11308069ul, 13256687ul,
+        15541093ul, 18219150ul, 21358692ul, 25039243ul, 29354030ul, 34412345ul, 40342314ul, 47294141ul,
+        55443913ul, 64998062ul, 76198591ul, 89329206ul, 104722501ul, 122768384ul, 143923951ul, 168725065ul,
+        197799931ul, 231885006ul, 271843654ul, 318688014ul, 373604640ul, 437984551ul, 513458471ul, 601938129ul,
+        705664687ul, 827265505ul, 969820693ul, 1136941128ul, 1332859917ul, 1562539621ul, 1831797952ul, 0ul
+    },
+    { // 2^32 buckets, common ratio 1.179586
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 8ul,
+        10ul, 12ul, 15ul, 18ul, 22ul, 26ul, 31ul, 37ul,
+        44ul, 52ul, 62ul, 74ul, 88ul, 104ul, 123ul, 146ul,
+        173ul, 205ul, 242ul, 286ul, 338ul, 399ul, 471ul, 556ul,
+        656ul, 774ul, 913ul, 1077ul, 1271ul, 1500ul, 1770ul, 2088ul,
+        2463ul, 2906ul, 3428ul, 4044ul, 4771ul, 5628ul, 6639ul, 7832ul,
+        9239ul, 10899ul, 12857ul, 15166ul, 17890ul, 21103ul, 24893ul, 29364ul,
+        34638ul, 40859ul, 48197ul, 56853ul, 67064ul, 79108ul, 93315ul, 110074ul,
+        129842ul, 153160ul, 180666ul, 213112ul, 251384ul, 296530ul, 349783ul, 412600ul,
+        486698ul, 574103ul, 677204ul, 798821ul, 942279ul, 1111500ul, 1311110ul, 1546568ul,
+        1824311ul, 2151932ul, 2538389ul, 2994249ul, 3531975ul, 4166269ul, 4914473ul, 5797044ul,
+        6838113ul, 8066143ul, 9514710ul, 11223420ul, 13238990ul, 15616528ul, 18421039ul, 21729201ul,
+        25631463ul, 30234517ul, 35664215ul, 42069011ul, 49624019ul, 58535801ul, 69048015ul, 81448076ul,
+        96075015ul, 113328748ul, 133681011ul, 157688257ul, 186006869ul, 219411109ul, 258814285ul, 305293721ul,
+        360120216ul, 424792785ul, 501079645ul, 591066561ul, 697213872ul, 822423760ul, 970119597ul, 1144339547ul,
+        1349846970ul, 1592260660ul, 1878208468ul, 2215508514ul, 2613382944ul, 3082710072ul, 3636321807ul, 0ul
+    },
+    { // 2^33 buckets, common ratio 1.186137
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 8ul,
+        10ul, 12ul, 15ul, 18ul, 22ul, 27ul, 33ul, 40ul,
+        48ul, 57ul, 68ul, 81ul, 97ul, 116ul, 138ul, 164ul,
+        195ul, 232ul, 276ul, 328ul, 390ul, 463ul, 550ul, 653ul,
+        775ul, 920ul, 1092ul, 1296ul, 1538ul, 1825ul, 2165ul, 2568ul,
+        3046ul, 3613ul, 4286ul, 5084ul, 6031ul, 7154ul, 8486ul, 10066ul,
+        11940ul, 14163ul, 16800ul, 19928ul, 23638ul, 28038ul, 33257ul, 39448ul,
+        46791ul, 55501ul, 65832ul, 78086ul, 92621ul, 109862ul, 130312ul, 154568ul,
+        183339ul, 217466ul, 257945ul, 305959ul, 362910ul, 430461ul, 510586ul, 605625ul,
+        718355ul, 852068ul, 1010670ul, 1198794ul, 1421934ul, 1686609ul, 2000550ul, 2372927ul,
+        2814617ul, 3338522ul, 3959945ul, 4697038ul, 5571331ul, 6608362ul, 7838423ul, 9297444ul,
+        11028042ul, 13080769ul, 15515584ul, 18403608ul, 21829200ul, 25892421ul, 30711958ul, 36428589ul,
+        43209296ul, 51252144ul, 60792063ul, 72107713ul, 85529624ul, 101449849ul, 120333416ul, 142731913ul,
+        169299598ul, 200812511ul, 238191142ul, 282527318ul, 335116095ul, 397493587ul, 471481836ul, 559242033ul,
+        663337646ul, 786809300ul, 933263592ul, 1106978441ul, 1313028044ul, 1557431094ul, 1847326585ul, 2191182342ul,
+        2599042365ul, 3082820213ul, 3656646999ul, 4337284159ul, 5144613052ul, 6102215691ul, 7238063575ul, 0ul
+    },
+    { // 2^34 buckets, common ratio 1.193436
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 6ul, 8ul,
+        10ul, 12ul, 15ul, 18ul, 22ul, 27ul, 33ul, 40ul,
+        48ul, 58ul, 70ul, 84ul, 101ul, 121ul, 145ul, 174ul,
+        208ul, 249ul, 298ul, 356ul, 425ul, 508ul, 607ul, 725ul,
+        866ul, 1034ul, 1235ul, 1474ul, 1760ul, 2101ul, 2508ul, 2994ul,
+        3574ul, 4266ul, 5092ul, 6077ul, 7253ul, 8656ul, 10331ul, 12330ul,
+        14716ul, 17563ul, 20961ul, 25016ul, 29855ul, 35631ul, 42524ul, 50750ul,
+        60567ul, 72283ul, 86266ul, 102953ul, 122868ul, 146636ul, 175001ul, 208853ul,
+        249253ul, 297468ul, 355010ul, 423682ul, 505638ul, 603447ul, 720176ul, 859484ul,
+        1025740ul, 1224156ul, 1460952ul, 1743553ul, 2080819ul, 2483325ul, 2963690ul, 3536975ul,
+        4221154ul, 5037678ul, 6012147ul, 7175113ul, 8563039ul, 10219440ul, 12196248ul, 14555442ul,
+        17370989ul, 20731165ul, 24741320ul, 29527183ul, 35238804ul, 42055259ul, 50190262ul, 59898867ul,
+        71485466ul, 85313331ul, 101816003ul, 121510887ul, 145015471ul, 173066688ul, 206544021ul, 246497076ul,
+        294178491ul, 351083210ul, 418995352ul, 500044149ul, 596770703ul, 712207657ul, 849974277ul, 1014389924ul,
+        1210609481ul, 1444784969ul, 1724258433ul, 2057792134ul, 2455843268ul, 2930891832ul, 3497831903ul, 4174438608ul,
+        4981925426ul, 5945609286ul, 7095704322ul, 8468269172ul, 10106337513ul, 12061267285ul, 14394350905ul, 0ul
+    },
+    { // 2^35 buckets, common ratio 1.2
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 7ul, 9ul,
+        11ul, 14ul, 17ul, 21ul, 26ul, 32ul, 39ul, 47ul,
+        57ul, 69ul, 83ul, 100ul, 121ul, 146ul, 176ul, 212ul,
+        255ul, 307ul, 369ul, 443ul, 532ul, 639ul, 767ul, 921ul,
+        1106ul, 1328ul, 1594ul, 1913ul, 2296ul, 2756ul, 3308ul, 3970ul,
+        4765ul, 5719ul, 6863ul, 8236ul, 9884ul, 11861ul, 14234ul, 17081ul,
+        20498ul, 24598ul, 29518ul, 35422ul, 42507ul, 51009ul, 61211ul, 73454ul,
+        88145ul, 105775ul, 126931ul, 152318ul, 182782ul, 219339ul, 263207ul, 315849ul,
+        379019ul, 454823ul, 545788ul, 654946ul, 785936ul, 943124ul, 1131749ul, 1358099ul,
+        1629719ul, 1955663ul, 2346796ul, 2816156ul, 3379388ul, 4055266ul, 4866320ul, 5839585ul,
+        7007503ul, 8409004ul, 10090806ul, 12108968ul, 14530763ul, 17436917ul, 20924302ul, 25109164ul,
+        30130998ul, 36157200ul, 43388642ul, 52066373ul, 62479651ul, 74975585ul, 89970706ul, 107964852ul,
+        129557828ul, 155469400ul, 186563288ul, 223875955ul, 268651157ul, 322381402ul, 386857698ul, 464229257ul,
+        557075131ul, 668490184ul, 802188253ul, 962625942ul, 1155151177ul, 1386181468ul, 1663417828ul, 1996101473ul,
+        2395321863ul, 2874386350ul, 3449263758ul, 4139116675ul, 4966940208ul, 5960328487ul, 7152394469ul, 8582873704ul,
+        10299448855ul, 12359339118ul, 14831207531ul, 17797449745ul, 21356940543ul, 25628329670ul, 30753996827ul, 0ul
+    },
+    { // 2^36 buckets, common ratio 1.206733
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 7ul, 9ul,
+        11ul, 14ul, 17ul, 21ul, 26ul, 32ul, 39ul, 48ul,
+        58ul, 70ul, 85ul, 103ul, 125ul, 151ul, 183ul, 221ul,
+        267ul, 323ul, 390ul, 471ul, 569ul, 687ul, 830ul, 1002ul,
+        1210ul, 1461ul, 1764ul, 2129ul, 2570ul, 3102ul, 3744ul, 4519ul,
+        5454ul, 6582ul, 7943ul, 9586ul, 11568ul, 13960ul, 16846ul, 20329ul,
+        24532ul, 29604ul, 35725ul, 43111ul, 52024ul, 62780ul, 75759ul, 91421ul,
+        110321ul, 133128ul, 160650ul, 193862ul, 233940ul, 282304ul, 340666ul, 411093ul,
+        496080ul, 598637ul, 722396ul, 871740ul, 1051958ul, 1269433ul, 1531867ul, 1848555ul,
+        2230713ul, 2691875ul, 3248375ul, 3919922ul, 4730300ul, 5708210ul, 6888286ul, 8312322ul,
+        10030754ul, 12104442ul, 14606830ul, 17626544ul, 21270533ul, 25667854ul, 30974247ul, 37377646ul,
+        45104839ul, 54429498ul, 65681871ul, 79260481ul, 95646238ul, 115419471ul, 139280484ul, 168074355ul,
+        202820869ul, 244750634ul, 295348664ul, 356406976ul, 430088056ul, 519001446ul, 626296166ul, 755772244ul,
+        912015299ul, 1100558948ul, 1328080789ul, 1602638900ul, 1933957230ul, 2333769988ul, 2816237232ul, 3398446371ul,
+        4101017346ul, 4948832918ul, 5971919937ul, 7206512792ul, 8696336718ul, 10494156396ul, 12663644709ul, 15281637824ul,
+        18440856479ul, 22253189847ul, 26853658285ul, 32405195311ul, 39104418176ul, 47188591404ul, 56944029922ul, 0ul
+    },
+    { // 2^37 buckets, common ratio 1.21412
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 7ul, 9ul,
+        11ul, 14ul, 17ul, 21ul, 26ul, 32ul, 39ul, 48ul,
+        59ul, 72ul, 88ul, 107ul, 130ul, 158ul, 192ul, 234ul,
+        285ul, 347ul, 422ul, 513ul, 623ul, 757ul, 920ul, 1117ul,
+        1357ul, 1648ul, 2001ul, 2430ul, 2951ul, 3583ul, 4351ul, 5283ul,
+        6415ul, 7789ul, 9457ul, 11482ul, 13941ul, 16927ul, 20552ul, 24953ul,
+        30296ul, 36783ul, 44659ul, 54222ul, 65833ul, 79930ul, 97045ul, 117825ul,
+        143054ul, 173685ul, 210875ul, 256028ul, 310849ul, 377408ul, 458219ul, 556333ul,
+        675456ul, 820085ul, 995682ul, 1208878ul, 1467723ul, 1781992ul, 2163553ul, 2626814ul,
+        3189268ul, 3872155ul, 4701261ul, 5707896ul, 6930071ul, 8413939ul, 10215532ul, 12402883ul,
+        15058589ul, 18282935ul, 22197678ul, 26950646ul, 32721320ul, 39727611ul, 48234089ul, 58561974ul,
+        71101266ul, 86325472ul, 104809485ul, 127251296ul, 154498348ul, 187579539ul, 227744076ul, 276508645ul,
+        335714685ul, 407597924ul, 494872804ul, 600834984ul, 729485790ul, 885683310ul, 1075325848ul, 1305574652ul,
+        1585124337ul, 1924531209ul, 2336611890ul, 2836927299ul, 3444370259ul, 4181878924ul, 5077302967ul, 6164455233ul,
+        7484388575ul, 9086946085ul, 11032643257ul, 13394953167ul, 16263080947ul, 19745332334ul, 23973203494ul, 29106346555ul,
+        35338598365ul, 42905300122ul, 52092184289ul, 63246164373ul, 76788435012ul, 93230377052ul, 113192868221ul, 0ul
+    },
+    { // 2^38 buckets, common ratio 1.221013
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 7ul, 9ul,
+        11ul, 14ul, 18ul, 22ul, 27ul, 33ul, 41ul, 51ul,
+        63ul, 77ul, 95ul, 116ul, 142ul, 174ul, 213ul, 261ul,
+        319ul, 390ul, 477ul, 583ul, 712ul, 870ul, 1063ul, 1298ul,
+        1585ul, 1936ul, 2364ul, 2887ul, 3526ul, 4306ul, 5258ul, 6421ul,
+        7841ul, 9574ul, 11690ul, 14274ul, 17429ul, 21282ul, 25986ul, 31730ul,
+        38743ul, 47306ul, 57762ul, 70529ul, 86117ul, 105150ul, 128390ul, 156766ul,
+        191414ul, 233719ul, 285374ul, 348446ul, 425458ul, 519490ul, 634305ul, 774495ul,
+        945669ul, 1154675ul, 1409874ul, 1721475ul, 2101944ul, 2566501ul, 3133731ul, 3826327ul,
+        4671995ul, 5704567ul, 6965351ul, 8504784ul, 10384452ul, 12679551ul, 15481896ul, 18903596ul,
+        23081536ul, 28182855ul, 34411631ul, 42017048ul, 51303360ul, 62642067ul, 76486776ul, 93391344ul,
+        114032041ul, 139234599ul, 170007249ul, 207581053ul, 253459154ul, 309476910ul, 377875315ul, 461390654ul,
+        563363964ul, 687874696ul, 839903912ul, 1025533554ul, 1252189751ul, 1528939902ul, 1866855421ul, 2279454645ul,
+        2783243641ul, 3398376529ul, 4149461751ul, 5066546534ul, 6186318930ul, 7553575527ul, 9223013537ul, 11261418967ul,
+        13750338394ul, 16789341246ul, 20500003083ul, 25030769239ul, 30562893388ul, 37317688615ul, 45565381061ul, 55635920345ul,
+        67932179224ul, 82946070551ul, 101278226290ul, 123662025848ul, 150992934977ul, 184364328957ul, 225111233165ul, 0ul
+    },
+    { // 2^39 buckets, common ratio 1.227545
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 7ul, 9ul,
+        12ul, 15ul, 19ul, 24ul, 30ul, 37ul, 46ul, 57ul,
+        70ul, 86ul, 106ul, 131ul, 161ul, 198ul, 244ul, 300ul,
+        369ul, 453ul, 557ul, 684ul, 840ul, 1032ul, 1267ul, 1556ul,
+        1911ul, 2346ul, 2880ul, 3536ul, 4341ul, 5329ul, 6542ul, 8031ul,
+        9859ul, 12103ul, 14857ul, 18238ul, 22388ul, 27483ul, 33737ul, 41414ul,
+        50838ul, 62406ul, 76607ul, 94039ul, 115438ul, 141706ul, 173951ul, 213533ul,
+        262122ul, 321767ul, 394984ul, 484861ul, 595189ul, 730622ul, 896872ul, 1100951ul,
+        1351467ul, 1658987ul, 2036482ul, 2499874ul, 3068708ul, 3766978ul, 4624136ul, 5676336ul,
+        6967959ul, 8553484ul, 10499787ul, 12888962ul, 15821782ul, 19421950ul, 23841319ul, 29266293ul,
+        35925693ul, 44100406ul, 54135234ul, 66453438ul, 81574588ul, 100136480ul, 122922038ul, 150892336ul,
+        185227137ul, 227374651ul, 279112622ul, 342623310ul, 420585539ul, 516287686ul, 633766380ul, 777976766ul,
+        955001508ul, 1172307349ul, 1439060052ul, 1766511005ul, 2168471793ul, 2661896757ul, 3267598116ul, 4011123805ul,
+        4923835064ul, 6044229227ul, 7419563506ul, 9107848255ul, 11180293796ul, 13724314005ul, 16847213351ul, 20680712900ul,
+        25386506192ul, 31163079327ul, 38254082929ul, 46958609108ul, 57643806896ul, 70760368260ul, 86861537881ul, 106626448513ul,
+        130888766189ul, 160671853498ul, 197231934092ul, 242111079065ul, 297202250111ul, 364829142938ul, 447844198646ul, 0ul
+    },
+    { // 2^40 buckets, common ratio 1.234712
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 7ul, 9ul,
+        12ul, 15ul, 19ul, 24ul, 30ul, 38ul, 47ul, 59ul,
+        73ul, 91ul, 113ul, 140ul, 173ul, 214ul, 265ul, 328ul,
+        405ul, 501ul, 619ul, 765ul, 945ul, 1167ul, 1441ul, 1780ul,
+        2198ul, 2714ul, 3352ul, 4139ul, 5111ul, 6311ul, 7793ul, 9623ul,
+        11882ul, 14671ul, 18115ul, 22367ul, 27617ul, 34100ul, 42104ul, 51987ul,
+        64189ul, 79255ul, 97858ul, 120827ul, 149187ul, 184203ul, 227438ul, 280821ul,
+        346734ul, 428117ul, 528602ul, 652672ul, 805862ul, 995008ul, 1228549ul, 1516905ul,
+        1872941ul, 2312543ul, 2855325ul, 3525505ul, 4352984ul, 5374682ul, 6636185ul, 8193778ul,
+        10116957ul, 12491529ul, 15423441ul, 19043508ul, 23513248ul, 29032090ul, 35846271ul, 44259822ul,
+        54648134ul, 67474708ul, 83311832ul, 102866120ul, 127010034ul, 156820814ul, 193628542ul, 239075486ul,
+        295189373ul, 364473863ul, 450020255ul, 555645412ul, 686062061ul, 847089063ul, 1045911036ul, 1291398912ul,
+        1594505740ul, 1968755379ul, 2430845901ul, 3001394616ul, 3705857964ul, 4575667316ul, 5649631365ul, 6975667669ul,
+        8612940612ul, 10634501170ul, 13130546259ul, 16212443094ul, 20017698114ul, 24716092168ul, 30517255709ul, 37680021974ul,
+        46523975468ul, 57443711015ul, 70926439583ul, 87573726402ul, 108128331282ul, 133507348678ul, 164843126124ul, 203533786712ul,
+        251305609808ul, 310290053269ul, 383118853699ul, 473041447875ul, 584069954394ul, 721158184253ul, 890422667358ul, 0ul
+    },
+    { // 2^41 buckets, common ratio 1.242165
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 7ul, 9ul,
+        12ul, 15ul, 19ul, 24ul, 30ul, 38ul, 48ul, 60ul,
+        75ul, 94ul, 117ul, 146ul, 182ul, 227ul, 282ul, 351ul,
+        436ul, 542ul, 674ul, 838ul, 1041ul, 1294ul, 1608ul, 1998ul,
+        2482ul, 3084ul, 3831ul, 4759ul, 5912ul, 7344ul, 9123ul, 11333ul,
+        14078ul, 17488ul, 21723ul, 26984ul, 33519ul, 41637ul, 51721ul, 64247ul,
+        79806ul, 99133ul, 123140ul, 152961ul, 190003ul, 236016ul, 293171ul, 364167ul,
+        452356ul, 561901ul, 697974ul, 866999ul, 1076956ul, 1337758ul, 1661717ul, 2064127ul,
+        2563987ul, 3184895ul, 3956166ul, 4914211ul, 6104261ul, 7582500ul, 9418716ul, 11699600ul,
+        14532834ul, 18052178ul, 22423784ul, 27854039ul, 34599312ul, 42978054ul, 53385834ul, 66314013ul,
+        82372944ul, 102320786ul, 127099297ul, 157878295ul, 196110888ul, 243602076ul, 302593966ul, 375871625ul,
+        466894566ul, 579960075ul, 720406089ul, 894863208ul, 1111567730ul, 1380750496ul, 1715119898ul, 2130461856ul,
+        2646385087ul, 3287246851ul, 4083302885ul, 5072135804ul, 6300429416ul, 7826172714ul, 9721397591ul, 12075579542ul,
+        14999861893ul, 18632302990ul, 23144394075ul, 28749155559ul, 35711193937ul, 44359194126ul, 55101437017ul, 68445074829ul,
+        85020074284ul, 105608957976ul, 131183748058ul, 162951856399ul, 202413087725ul, 251430446930ul, 312318093429ul, 387950594982ul,
+        481898638962ul, 598597608142ul, 743556979628ul, 923620432880ul, 1147288946787ul, 1425122139530ul, 1770236798904ul, 0ul
+    },
+    { // 2^42 buckets, common ratio 1.25
+        0ul, 1ul, 2ul, 3ul, 4ul, 5ul, 7ul, 9ul,
+        12ul, 15ul, 19ul, 24ul, 30ul, 38ul, 48ul, 60ul,
+        75ul, 94ul, 118ul, 148ul, 185ul, 232ul, 290ul, 363ul,
+        454ul, 568ul, 710ul, 888ul, 1110ul, 1388ul, 1735ul, 2169ul,
+        2712ul, 3390ul, 4238ul, 5298ul, 6623ul, 8279ul, 10349ul, 12937ul,
+        16172ul, 20215ul, 25269ul, 31587ul, 39484ul, 49355ul, 61694ul, 77118ul,
+        96398ul, 120498ul, 150623ul, 188279ul, 235349ul, 294187ul, 367734ul, 459668ul,
+        574585ul, 718232ul, 897790ul, 1122238ul, 1402798ul, 1753498ul, 2191873ul, 2739842ul,
+        3424803ul, 4281004ul, 5351255ul, 6689069ul, 8361337ul, 10451672ul, 13064590ul, 16330738ul,
+        20413423ul, 25516779ul, 31895974ul, 39869968ul, 49837460ul, 62296825ul, 77871032ul, 97338790ul,
+        121673488ul, 152091860ul, 190114825ul, 237643532ul, 297054415ul, 371318019ul, 464147524ul, 580184405ul,
+        725230507ul, 906538134ul, 1133172668ul, 1416465835ul, 1770582294ul, 2213227868ul, 2766534835ul, 3458168544ul,
+        4322710680ul, 5403388350ul, 6754235438ul, 8442794298ul, 10553492873ul, 13191866092ul, 16489832615ul, 20612290769ul,
+        25765363462ul, 32206704328ul, 40258380410ul, 50322975513ul, 62903719392ul, 78629649240ul, 98287061550ul, 122858826938ul,
+        153573533673ul, 191966917092ul, 239958646365ul, 299948307957ul, 374935384947ul, 468669231184ul, 585836538980ul, 732295673725ul,
+        915369592157ul, 1144211990197ul, 1430264987747ul, 1787831234684ul, 2234789043355ul, 2793486304194ul, 3491857880243ul, 0ul
+    },
+    { // 2^43 buckets, common ratio 1.25523
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        14ul, 18ul, 23ul, 29ul, 37ul, 47ul, 59ul, 75ul,
+        95ul, 120ul, 151ul, 190ul, 239ul, 300ul, 377ul, 474ul,
+        595ul, 747ul, 938ul, 1178ul, 1479ul, 1857ul, 2331ul, 2926ul,
+        3673ul, 4611ul, 5788ul, 7266ul, 9121ul, 11449ul, 14372ul, 18041ul,
+        22646ul, 28426ul, 35682ul, 44790ul, 56222ul, 70572ul, 88585ul, 111195ul,
+        139576ul, 175200ul, 219917ul, 276047ul, 346503ul, 434941ul, 545951ul, 685295ul,
+        860203ul, 1079753ul, 1355339ul, 1701263ul, 2135477ul, 2680515ul, 3364663ul, 4223426ul,
+        5301371ul, 6654440ul, 8352853ul, 10484752ul, 13160775ul, 16519799ul, 20736147ul, 26028633ul,
+        32671920ul, 41010773ul, 51477951ul, 64616666ul, 81108775ul, 101810164ul, 127795168ul, 160412323ul,
+        201354353ul, 252746015ul, 317254368ul, 398227185ul, 499866690ul, 627447641ul, 787591072ul, 988607902ul,
+        1240930248ul, 1557652814ul, 1955212464ul, 2454241244ul, 3080637114ul, 3866907971ul, 4853858699ul, 6092708812ul,
+        7647750578ul, 9599685576ul, 12049812846ul, 15125285976ul, 18985711959ul, 23831434273ul, 29913930050ul, 37548860920ul,
+        47132454814ul, 59162068898ul, 74262000782ul, 93215887525ul, 117007373833ul, 146871160001ul, 184357078818ul, 231410526818ul,
+        290473423996ul, 364610941465ul, 457670573807ul, 574481811454ul, 721106775440ul, 905154821646ul, 1136177441473ul, 1426163952996ul,
+        1790163707342ul, 2247067100772ul, 2820585924439ul, 3540483928767ul, 4444121464710ul, 5578394363725ul, 7002167677987ul, 0ul
+    },
+    { // 2^44 buckets, common ratio 1.262626
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        14ul, 18ul, 23ul, 30ul, 38ul, 48ul, 61ul, 78ul,
+        99ul, 125ul, 158ul, 200ul, 253ul, 320ul, 405ul, 512ul,
+        647ul, 817ul, 1032ul, 1304ul, 1647ul, 2080ul, 2627ul, 3317ul,
+        4189ul, 5290ul, 6680ul, 8435ul, 10651ul, 13449ul, 16982ul, 21442ul,
+        27074ul, 34185ul, 43163ul, 54499ul, 68812ul, 86884ul, 109703ul, 138514ul,
+        174892ul, 220824ul, 278819ul, 352045ul, 444502ul, 561240ul, 708637ul, 894744ul,
+        1129728ul, 1426425ul, 1801042ul, 2274043ul, 2871266ul, 3625336ul, 4577444ul, 5779601ul,
+        7297475ul, 9213983ul, 11633815ul, 14689158ul, 18546914ul, 23417817ul, 29567946ul, 37333259ul,
+        47137946ul, 59517599ul, 75148472ul, 94884419ul, 119803540ul, 151267071ul, 190993745ul, 241153679ul,
+        304486918ul, 384453116ul, 485420520ul, 612904595ul, 773869309ul, 977107551ul, 1233721450ul, 1557728844ul,
+        1966829021ul, 2483369562ul, 3135567106ul, 3959048716ul, 4998798050ul, 6311612647ul, 7969206558ul, 10062127814ul,
+        12704704716ul, 16041291157ul, 20254152121ul, 25573420128ul, 32289666490ul, 40769774118ul, 51476978932ul, 64996174673ul,
+        82065863417ul, 103618497123ul, 130831413927ul, 165191151632ul, 208574651595ul, 263351788871ul, 332514829444ul, 419841886301ul,
+        530103303324ul, 669322240977ul, 845103698576ul, 1067049946382ul, 1347285060984ul, 1701117217338ul, 2147874915952ul, 2711962825110ul,
+        3424194914776ul, 4323477706190ul, 5458935586657ul, 6892594287373ul, 8702769112434ul, 10988343005054ul, 13874168145425ul, 0ul
+    },
+    { // 2^45 buckets, common ratio 1.269855
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        14ul, 18ul, 23ul, 30ul, 39ul, 50ul, 64ul, 82ul,
+        105ul, 134ul, 171ul, 218ul, 277ul, 352ul, 447ul, 568ul,
+        722ul, 917ul, 1165ul, 1480ul, 1880ul, 2388ul, 3033ul, 3852ul,
+        4892ul, 6213ul, 7890ul, 10020ul, 12724ul, 16158ul, 20519ul, 26057ul,
+        33089ul, 42019ul, 53359ul, 67759ul, 86045ul, 109265ul, 138751ul, 176194ul,
+        223741ul, 284119ul, 360790ul, 458151ul, 581786ul, 738784ul, 938149ul, 1191314ul,
+        1512797ul, 1921033ul, 2439434ul, 3097728ul, 3933666ul, 4995186ul, 6343163ul, 8054898ul,
+        10228553ul, 12988780ul, 16493868ul, 20944822ul, 26596888ul, 33774192ul, 42888328ul, 54461959ul,
+        69158793ul, 87821641ul, 111520752ul, 141615188ul, 179830758ul, 228358992ul, 289982813ul, 368236132ul,
+        467606502ul, 593792466ul, 754030346ul, 957509222ul, 1215897895ul, 1544014049ul, 1960673995ul, 2489771720ul,
+        3161649124ul, 4014836020ul, 5098259685ul, 6474050667ul, 8221105755ul, 10439612433ul, 13256794281ul, 16834206800ul,
+        21377002054ul, 27145693423ul, 34471095131ul, 43773293281ul, 55585736322ul, 70585826444ul, 89633766223ul, 113821888218ul,
+        144537296417ul, 183541411784ul, 233070983578ul, 295966359080ul, 375834367549ul, 477255159235ul, 606044860936ul, 769589110478ul,
+        977266597149ul, 1240986896644ul, 1575873443474ul, 2001130806911ul, 2541146005697ul, 3226887018064ul, 4097678686705ul, 5203457860619ul,
+        6607637098313ul, 8390741155691ul, 10655024798468ul, 13530336754456ul, 17181566082821ul, 21818097983491ul, 27705821304216ul, 0ul
+    },
+    { // 2^46 buckets, common ratio 1.276308
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        15ul, 20ul, 26ul, 34ul, 44ul, 57ul, 73ul, 94ul,
+        120ul, 154ul, 197ul, 252ul, 322ul, 411ul, 525ul, 671ul,
+        857ul, 1094ul, 1397ul, 1784ul, 2277ul, 2907ul, 3711ul, 4737ul,
+        6046ul, 7717ul, 9850ul, 12572ul, 16046ul, 20480ul, 26139ul, 33362ul,
+        42581ul, 54347ul, 69364ul, 88530ul, 112992ul, 144213ul, 184061ul, 234919ul,
+        299829ul, 382675ul, 488412ul, 623365ul, 795606ul, 1015439ul, 1296013ul, 1654112ul,
+        2111157ul, 2694487ul, 3438996ul, 4389218ul, 5601994ul, 7149870ul, 9125436ul, 11646867ul,
+        14864989ul, 18972304ul, 24214503ul, 30905163ul, 39444505ul, 50343335ul, 64253599ul, 82007379ul,
+        104666669ul, 133586901ul, 170498023ul, 217607981ul, 277734795ul, 354475125ul, 452419417ul, 577426495ul,
+        736974021ul, 940605795ul, 1200502646ul, 1532211060ul, 1955573143ul, 2495913531ul, 3185554259ul, 4065748196ul,
+        5189146707ul, 6622949147ul, 8452922586ul, 10788532217ul, 13769489335ul, 17574108575ul, 22429974322ul, 28627554333ul,
+        36537574912ul, 46633196987ul, 59518319605ul, 75963703917ul, 96953078498ul, 123741983942ul, 157932876677ul, 201570984567ul,
+        257266648174ul, 328351465886ul, 419077583180ul, 534872047092ul, 682661440846ul, 871286217614ul, 1112029517975ul, 1419292103844ul,
+        1811453782002ul, 2311972845788ul, 2950789301261ul, 3766115815892ul, 4806723520602ul, 6134859397052ul, 7829969762205ul, 9993452581245ul,
+        12754722882285ul, 16278954093322ul, 20776958372067ul, 26517796949356ul, 33844874810582ul, 43196482465403ul, 55132013571533ul, 0ul
+    },
+    { // 2^47 buckets, common ratio 1.283932
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        15ul, 20ul, 26ul, 34ul, 44ul, 57ul, 74ul, 96ul,
+        124ul, 160ul, 206ul, 265ul, 341ul, 438ul, 563ul, 723ul,
+        929ul, 1193ul, 1532ul, 1967ul, 2526ul, 3244ul, 4166ul, 5349ul,
+        6868ul, 8819ul, 11323ul, 14538ul, 18666ul, 23966ul, 30771ul, 39508ul,
+        50726ul, 65129ul, 83622ul, 107365ul, 137850ul, 176991ul, 227245ul, 291768ul,
+        374611ul, 480976ul, 617541ul, 792881ul, 1018006ul, 1307051ul, 1678165ul, 2154650ul,
+        2766425ul, 3551902ul, 4560401ul, 5855245ul, 7517737ul, 9652263ul, 12392850ul, 15911577ul,
+        20429383ul, 26229938ul, 33677456ul, 43239563ul, 55516658ul, 71279613ul, 91518174ul, 117503110ul,
+        150866000ul, 193701681ul, 248699781ul, 319313600ul, 409976940ul, 526382501ul, 675839322ul, 867731713ul,
+        1114108489ul, 1430439508ul, 1836587017ul, 2358052788ul, 3027579363ul, 3887205938ul, 4990907981ul, 6407986320ul,
+        8227418504ul, 10563445653ul, 13562745594ul, 17413642678ul, 22357932559ul, 28706064409ul, 36856633845ul, 47321410523ul,
+        60757471865ul, 78008460581ul, 100157556517ul, 128595488909ul, 165107859485ul, 211987259390ul, 272177219690ul, 349457034029ul,
+        448679058340ul, 576073387540ul, 739639039673ul, 949646209738ul, 1219281129439ul, 1565474023232ul, 2009962147566ul, 2580654660949ul,
+        3313385024261ul, 4254160963544ul, 5462053269157ul, 7012904817371ul, 9004092701772ul, 11560642486019ul, 14843078488434ul, 19057503013371ul,
+        24468537398603ul, 31415937439798ul, 40335926465211ul, 51788585552307ul, 66493020702570ul, 85372515101553ul, 109612501549101ul, 0ul
+    },
+    { // 2^48 buckets, common ratio 1.291902
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        15ul, 20ul, 26ul, 34ul, 44ul, 57ul, 74ul, 96ul,
+        125ul, 162ul, 210ul, 272ul, 352ul, 455ul, 588ul, 760ul,
+        982ul, 1269ul, 1640ul, 2119ul, 2738ul, 3538ul, 4571ul, 5906ul,
+        7630ul, 9858ul, 12736ul, 16454ul, 21257ul, 27462ul, 35479ul, 45836ul,
+        59216ul, 76502ul, 98834ul, 127684ul, 164956ul, 213107ul, 275314ul, 355679ul,
+        459503ul, 593633ul, 766916ul, 990781ul, 1279992ul, 1653625ul, 2136322ul, 2759919ul,
+        3565545ul, 4606335ul, 5950934ul, 7688024ul, 9932174ul, 12831395ul, 16576905ul, 21415736ul,
+        27667032ul, 35743093ul, 46176572ul, 59655604ul, 77069191ul, 99565838ul, 128629300ul, 166176443ul,
+        214683671ul, 277350253ul, 358309332ul, 462900524ul, 598022088ul, 772585900ul, 998105228ul, 1289454087ul,
+        1665848245ul, 2152112590ul, 2780318444ul, 3591898809ul, 4640381062ul, 5994917325ul, 7744845359ul, 10005580792ul,
+        12926229297ul, 16699420785ul, 21574014211ul, 27871510944ul, 36007259229ul, 46517848271ul, 60096498709ul, 77638783635ul,
+        100301695669ul, 129579955829ul, 167404597107ul, 216270324784ul, 279400053466ul, 360957472805ul, 466321661565ul, 602441862070ul,
+        778295814001ul, 1005481876725ul, 1298983993277ul, 1678159948826ul, 2168018103702ul, 2800866807283ul, 3618445279006ul, 4674676497688ul,
+        6039223664601ul, 7802084805037ul, 10079528543014ul, 13021762540166ul, 16822840366874ul, 21733460208353ul, 28077499537959ul, 36273376293808ul,
+        46861645424421ul, 60540650919750ul, 78212584739437ul, 101042990431873ul, 130537635975448ul, 168641825951773ul, 217868703135525ul, 0ul
+    },
+    { // 2^49 buckets, common ratio 1.299366
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        15ul, 20ul, 26ul, 34ul, 45ul, 59ul, 77ul, 101ul,
+        132ul, 172ul, 224ul, 292ul, 380ul, 494ul, 642ul, 835ul,
+        1085ul, 1410ul, 1833ul, 2382ul, 3096ul, 4023ul, 5228ul, 6794ul,
+        8828ul, 11471ul, 14906ul, 19369ul, 25168ul, 32703ul, 42494ul, 55216ul,
+        71746ul, 93225ul, 121134ul, 157398ul, 204518ul, 265744ul, 345299ul, 448670ul,
+        582987ul, 757514ul, 984288ul, 1278951ul, 1661826ul, 2159321ul, 2805749ul, 3645695ul,
+        4737093ul, 6155218ul, 7997881ul, 10392175ul, 13503239ul, 17545650ul, 22798222ul, 29623235ul,
+        38491425ul, 50014449ul, 64987075ul, 84441996ul, 109721059ul, 142567814ul, 185247770ul, 240704654ul,
+        312763443ul, 406394184ul, 528054785ul, 686136433ul, 891542351ul, 1158439817ul, 1505237309ul, 1955854178ul,
+        2541370415ul, 3302170304ul, 4290727811ul, 5575225822ul, 7244258861ul, 9412943640ul, 12230858901ul, 15892362174ul,
+        20649995026ul, 26831901382ul, 34864460300ul, 45301694229ul, 58863481102ul, 76485205828ul, 99382275751ul, 129133949847ul,
+        167792263531ul, 218023561845ul, 283292402875ul, 368100515594ul, 478297293557ul, 621483239856ul, 807534189770ul, 1049282467857ul,
+        1363401960312ul, 1771558147902ul, 2301902419650ul, 2991013733230ul, 3886421542460ul, 5049884003503ul, 6561647564534ul, 8525981731717ul,
+        11078370755918ul, 14394858265883ul, 18704189366850ul, 24303587670616ul, 31579255431950ul, 41033010728784ul, 53316898908422ul, 69278165523856ul,
+        90017692638021ul, 116965928970549ul, 151981550948629ul, 197479659521763ul, 256598354743815ul, 333415177120945ul, 433228344139532ul, 0ul
+    },
+    { // 2^50 buckets, common ratio 1.306582
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        15ul, 20ul, 27ul, 36ul, 48ul, 63ul, 83ul, 109ul,
+        143ul, 187ul, 245ul, 321ul, 420ul, 549ul, 718ul, 939ul,
+        1227ul, 1604ul, 2096ul, 2739ul, 3579ul, 4677ul, 6111ul, 7985ul,
+        10434ul, 13633ul, 17813ul, 23275ul, 30411ul, 39735ul, 51918ul, 67836ul,
+        88634ul, 115808ul, 151313ul, 197703ul, 258316ul, 337512ul, 440988ul, 576187ul,
+        752836ul, 983642ul, 1285209ul, 1679231ul, 2194053ul, 2866711ul, 3745593ul, 4893925ul,
+        6394315ul, 8354697ul, 10916097ul, 14262776ul, 18635487ul, 24348792ul, 31813693ul, 41567198ul,
+        54310952ul, 70961711ul, 92717293ul, 121142744ul, 158282926ul, 206809618ul, 270213719ul, 353056375ul,
+        461297096ul, 602722471ul, 787506316ul, 1028941557ul, 1344396491ul, 1756564222ul, 2295095149ul, 2998729951ul,
+        3918086499ul, 5119301193ul, 6688786659ul, 8739448077ul, 11418805321ul, 14919605198ul, 19493687212ul, 25470100319ul,
+        33278773954ul, 43481446167ul, 56812073767ul, 74229631492ul, 96987098447ul, 126721594545ul, 165572151153ul, 216333588098ul,
+        282657566586ul, 369315281325ul, 482540689313ul, 630478966393ul, 823772452494ul, 1076326237131ul, 1406308459611ul, 1837457283253ul,
+        2400788564348ul, 3136827061634ul, 4098521694380ul, 5355054566046ul, 6996817765941ul, 9141915968549ul, 11944662612599ul, 15606680855487ul,
+        20391407880212ul, 26643045961369ul, 34811323586366ul, 45483847890056ul, 59428375762649ul, 77648044517332ul, 101453535284990ul, 132557360404938ul,
+        173197057630030ul, 226296153454353ul, 295674474895681ul, 386322939079347ul, 504762588355188ul, 659513699109383ul, 861708710881863ul, 0ul
+    },
+    { // 2^51 buckets, common ratio 1.314386
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        15ul, 20ul, 27ul, 36ul, 48ul, 64ul, 85ul, 112ul,
+        148ul, 195ul, 257ul, 338ul, 445ul, 585ul, 769ul, 1011ul,
+        1329ul, 1747ul, 2297ul, 3020ul, 3970ul, 5219ul, 6860ul, 9017ul,
+        11852ul, 15579ul, 20477ul, 26915ul, 35377ul, 46500ul, 61119ul, 80334ul,
+        105590ul, 138787ul, 182420ul, 239771ul, 315152ul, 414232ul, 544461ul, 715632ul,
+        940617ul, 1236334ul, 1625021ul, 2135905ul, 2807404ul, 3690013ul, 4850102ul, 6374907ul,
+        8379089ul, 11013358ul, 14475804ul, 19026795ul, 25008554ul, 32870894ul, 43205044ul, 56788106ul,
+        74641493ul, 98107735ul, 128951435ul, 169491963ul, 222777866ul, 292816111ul, 384873400ul, 505872213ul,
+        664911360ul, 873950190ul, 1148707904ul, 1509845599ul, 1984519933ul, 2608425237ul, 3428477641ul, 4506343048ul,
+        5923074260ul, 7785205945ul, 10232765781ul, 13449804188ul, 17678234465ul, 23236024066ul, 30541104965ul, 40142801102ul,
+        52763136178ul, 69351128046ul, 91154152494ul, 119811742808ul, 157478878601ul, 206988034931ul, 272062177386ul, 357594719853ul,
+        470017497086ul, 617784422705ul, 812007202505ul, 1067290907130ul, 1402832237114ul, 1843863067079ul, 2423547820038ul, 3185477349636ul,
+        4186946864075ul, 5503264383466ul, 7233413715895ul, 9507497793945ul, 12496522092084ul, 16425253813616ul, 21589123826109ul, 28376442328866ul,
+        37297598815457ul, 49023442095970ul, 64435726461322ul, 84693417415902ul, 111319843004949ul, 146317244300024ul, 192317338954576ul, 252779219835014ul,
+        332249470212826ul, 436704055534127ul, 573997701178552ul, 754454548298819ul, 991644503593082ul, 1303403662584705ul, 1713175539705653ul, 0ul
+    },
+    { // 2^52 buckets, common ratio 1.32242
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        15ul, 20ul, 27ul, 36ul, 48ul, 64ul, 85ul, 113ul,
+        150ul, 199ul, 264ul, 350ul, 463ul, 613ul, 811ul, 1073ul,
+        1419ul, 1877ul, 2483ul, 3284ul, 4343ul, 5744ul, 7596ul, 10046ul,
+        13286ul, 17570ul, 23235ul, 30727ul, 40634ul, 53736ul, 71062ul, 93974ul,
+        124274ul, 164343ul, 217331ul, 287403ul, 380068ul, 502610ul, 664662ul, 878963ul,
+        1162359ul, 1537127ul, 2032728ul, 2688121ul, 3554825ul, 4700972ul, 6216660ul, 8221036ul,
+        10871663ul, 14376905ul, 19012307ul, 25142256ul, 33248623ul, 43968645ul, 58145016ul, 76892133ul,
+        101683695ul, 134468553ul, 177823904ul, 235157888ul, 310977495ul, 411242860ul, 543835784ul, 719179319ul,
+        951057116ul, 1257696953ul, 1663203606ul, 2199453715ul, 2908601585ul, 3846392912ul, 5086546919ul, 6726551382ul,
+        8895326086ul, 11763357132ul, 15556098751ul, 20571696127ul, 27204422414ul, 35975672317ul, 47574948623ul, 62914063608ul,
+        83198816062ul, 110023778423ul, 145497645176ul, 192408996084ul, 254445504800ul, 336483824720ul, 444972939833ul, 588441115553ul,
+        778166300636ul, 1029062680089ul, 1360853070464ul, 1799619318845ul, 2379852581481ul, 3147164653254ul, 4161873483998ul, 5503744736996ul,
+        7278262120767ul, 9624919401242ul, 12728185924504ul, 16832007643393ul, 22258983565113ul, 29435725069103ul, 38926391576202ul, 51477038788294ul,
+        68074265687436ul, 90022770500494ul, 119047912257984ul, 157431340250819ul, 208190353136638ul, 275315087009383ul, 364082177646515ul, 481469553738298ul,
+        636704967750499ul, 841991384108401ul, 1113466247039856ul, 1472470035557282ul, 1947223825938259ul, 2575047733902851ul, 3405294626920026ul, 0ul
+    },
+    { // 2^53 buckets, common ratio 1.330434
+        0ul, 1ul, 2ul, 3ul, 4ul, 6ul, 8ul, 11ul,
+        15ul, 20ul, 27ul, 36ul, 48ul, 64ul, 86ul, 115ul,
+        153ul, 204ul, 272ul, 362ul, 482ul, 642ul, 855ul, 1138ul,
+        1515ul, 2016ul, 2683ul, 3570ul, 4750ul, 6320ul, 8409ul, 11188ul,
+        14885ul, 19804ul, 26348ul, 35055ul, 46639ul, 62051ul, 82555ul, 109834ul,
+        146127ul, 194413ul, 258654ul, 344123ul, 457833ul, 609117ul, 810390ul, 1078171ul,
+        1434436ul, 1908423ul, 2539031ul, 3378014ul, 4494225ul, 5979270ul, 7955024ul, 10583635ul,
+        14080828ul, 18733612ul, 24923834ul, 33159516ul, 44116547ul, 58694153ul, 78088695ul, 103891853ul,
+        138221250ul, 183894246ul, 244659151ul, 325502845ul, 433060041ul, 576157788ul, 766539891ul, 1019830707ul,
+        1356817411ul, 1805155968ul, 2401640812ul, 3195224508ul, 4251035211ul, 5655721630ul, 7524564152ul, 10010935718ul,
+        13318888898ul, 17719902163ul, 23575159690ul, 31365193176ul, 41729318312ul, 55518102408ul, 73863169101ul, 98270068915ul,
+        130741837401ul, 173943381090ul, 231420182142ul, 307889270446ul, 409626342778ul, 544980799280ul, 725060965488ul, 964645734985ul,
+        1283397449756ul, 1707475557403ul, 2271683475515ul, 3022324852940ul, 4021003636797ul, 5349679810695ul, 7117395720576ul, 9469225007074ul,
+        12598178569076ul, 16761044662024ul, 22299463102702ul, 29667963107063ul, 39471265781973ul, 52513912627195ul, 69866292980048ul, 92952489170385ul,
+        123667148698414ul, 164530974949600ul, 218897597322975ul, 291228798276126ul, 387460684733859ul, 515490854967201ul, 685826541955715ul, 912446925330734ul,
+        1213950380472837ul, 1615080817677130ul, 2148758375620439ul, 2858781124922011ul, 3803419506323306ul, 5060198493326507ul, 6732259943793661ul, 0ul
+    },
+    { // 2^54 buckets, common ratio 1.335375
+        0ul, 1ul, 2ul, 3ul, 5ul, 7ul, 10ul, 14ul,
+        19ul, 26ul, 35ul, 47ul, 63ul, 85ul, 114ul, 153ul,
+        205ul, 274ul, 366ul, 489ul, 653ul, 872ul, 1165ul, 1556ul,
+        2078ul, 2775ul, 3706ul, 4949ul, 6609ul, 8826ul, 11787ul, 15741ul,
+        21021ul, 28071ul, 37486ul, 50058ul, 66847ul, 89266ul, 119204ul, 159183ul,
+        212569ul, 283860ul, 379060ul, 506188ul, 675951ul, 902649ul, 1205375ul, 1609628ul,
+        2149457ul, 2870332ul, 3832970ul, 5118453ul, 6835054ul, 9127360ul, 12188448ul, 16276149ul,
+        21734762ul, 29024057ul, 38757999ul, 51756462ul, 69114283ul, 92293483ul, 123246406ul, 164580164ul,
+        219776229ul, 293483672ul, 391910745ul, 523347793ul, 698865534ul, 933247529ul, 1246235374ul, 1664191502ul,
+        2222319647ul, 2967629991ul, 3962898755ul, 5291955733ul, 7066745130ul, 9436754435ul, 12601605495ul, 16827868325ul,
+        22471513847ul, 30007896711ul, 40071793611ul, 53510869445ul, 71457074683ul, 95421987630ul, 127424132091ul, 170158994194ul,
+        227226058596ul, 303431986946ul, 405195474810ul, 541087887467ul, 722555211410ul, 964882130294ul, 1288479427813ul, 1720603153248ul,
+        2297650352083ul, 3068224727162ul, 4097230445804ul, 5471338907287ul, 7306288927207ul, 9756635220811ul, 13028766283454ul, 17398288142083ul,
+        23233238181527ul, 31025084306653ul, 41430120447018ul, 55324745076884ul, 73879278766193ul, 98656538289110ul, 131743470019424ul, 175926929869530ul,
+        234928415417897ul, 313717521312370ul, 418930519764105ul, 559429322454305ul, 747047904263236ul, 997589058821059ul, 1332155440903044ul, 1778927007103339ul,
+        2375534565588255ul, 3172229354982615ul, 4236115620620953ul, 5656802690853097ul, 7553952618165835ul, 10087359110078662ul, 13470406680998472ul, 0ul
+    },
+    { // 2^55 buckets, common ratio 1.343129
+        0ul, 1ul, 2ul, 3ul, 5ul, 7ul, 10ul, 14ul,
+        19ul, 26ul, 35ul, 48ul, 65ul, 88ul, 119ul, 160ul,
+        215ul, 289ul, 389ul, 523ul, 703ul, 945ul, 1270ul, 1706ul,
+        2292ul, 3079ul, 4136ul, 5556ul, 7463ul, 10024ul, 13464ul, 18084ul,
+        24290ul, 32625ul, 43820ul, 58856ul, 79052ul, 106178ul, 142611ul, 191545ul,
+        257270ul, 345547ul, 464115ul, 623367ul, 837263ul, 1124553ul, 1510420ul, 2028689ul,
+        2724792ul, 3659748ul, 4915514ul, 6602170ul, 8867567ul, 11910287ul, 15997053ul, 21486107ul,
+        28858615ul, 38760844ul, 52060816ul, 69924394ul, 93917485ul, 126143302ul, 169426732ul, 227561964ul,
+        305645082ul, 410520786ul, 551382389ul, 740577699ul, 994691414ul, 1335998923ul, 1794418950ul, 2410136200ul,
+        3237123918ul, 4347875137ul, 5839757354ul, 7843547682ul, 10534896659ul, 14149725624ul, 19004907377ul, 25526042978ul,
+        34284769570ul, 46048869599ul, 61849573963ul, 83071958828ul, 111576360213ul, 149861449447ul, 201283264551ul, 270349397646ul,
+        363114126604ul, 487709127845ul, 655056292102ul, 879825127978ul, 1181718678463ul, 1587200672749ul, 2131815313990ul, 2863303053602ul,
+        3845785478209ul, 5165386152820ul, 6937780138524ul, 9318333968936ul, 12515724947015ul, 16810233618104ul, 22578312921668ul, 30325587732448ul,
+        40731177502454ul, 54707227288501ul, 73478865604005ul, 98691598131611ul, 132555551337206ul, 178039210256568ul, 239129633342526ul, 321181954582510ul,
+        431388809941759ul, 579410837650780ul, 778223521450412ul, 1045254610345594ul, 1403911820105962ul, 1885634733513944ul, 2532650767172711ul, 3401676790555941ul,
+        4568890878044170ul, 6136610013458578ul, 8242259108932921ul, 11070417554610058ul, 14868999289356840ul, 19970984723591280ul, 26823609515900928ul, 0ul
+    },
+    { // 2^56 buckets, common ratio 1.350928
+        0ul, 1ul, 2ul, 3ul, 5ul, 7ul, 10ul, 14ul,
+        19ul, 26ul, 36ul, 49ul, 67ul, 91ul, 123ul, 167ul,
+        226ul, 306ul, 414ul, 560ul, 757ul, 1023ul, 1382ul, 1867ul,
+        2523ul, 3409ul, 4606ul, 6223ul, 8407ul, 11358ul, 15344ul, 20729ul,
+        28004ul, 37832ul, 51109ul, 69045ul, 93275ul, 126008ul, 170228ul, 229966ul,
+        310668ul, 419691ul, 566973ul, 765940ul, 1034730ul, 1397846ul, 1888390ul, 2551079ul,
+        3446324ul, 4655736ul, 6289564ul, 8496748ul, 11478495ul, 15506620ul, 20948327ul, 28299681ul,
+        38230831ul, 51647099ul, 69771510ul, 94256283ul, 127333448ul, 172018314ul, 232384349ul, 313934512ul,
+        424102907ul, 572932471ul, 773990488ul, 1045605383ul, 1412537536ul, 1908236437ul, 2577889936ul, 3482543564ul,
+        4704665435ul, 6355664027ul, 8586044169ul, 11599127039ul, 15669584901ul, 21168480192ul, 28597091529ul, 38632610206ul,
+        52189872869ul, 70504757911ul, 95246847997ul, 128671629009ul, 173826099866ul, 234826536567ul, 317233731404ul, 428559914104ul,
+        578953565764ul, 782124553136ul, 1056593918393ul, 1427382255050ul, 1928290582185ul, 2604981641175ul, 3519142505570ul, 4754107967119ul,
+        6422457325116ul, 8676277101449ul, 11721025229198ul, 15834260572492ul, 21390945158364ul, 28897625668928ul, 39038610174500ul, 52738349572964ul,
+        71245710419704ul, 96247821448899ul, 130023872021033ul, 175652882744136ul, 237294388612993ul, 320567621706704ul, 433063759692569ul, 585037936646804ul,
+        790344099813214ul, 1067697933726760ul, 1442382979709483ul, 1948555480381804ul, 2632358058530827ul, 3556126072917585ul, 4804070101900292ul, 6489952569380448ul,
+        8767458313347082ul, 11844204476769690ul, 16000666860767272ul, 21615748064076108ul, 29201318197259476ul, 39448876898910320ul, 53292590357493856ul, 0ul
+    },
+    { // 2^57 buckets, common ratio 1.358213
+        0ul, 1ul, 2ul, 3ul, 5ul, 7ul, 10ul, 14ul,
+        20ul, 28ul, 39ul, 53ul, 72ul, 98ul, 134ul, 183ul,
+        249ul, 339ul, 461ul, 627ul, 852ul, 1158ul, 1573ul, 2137ul,
+        2903ul, 3943ul, 5356ul, 7275ul, 9881ul, 13421ul, 18229ul, 24759ul,
+        33628ul, 45674ul, 62036ul, 84259ul, 114442ul, 155437ul, 211117ul, 286742ul,
+        389457ul, 528966ul, 718449ul, 975807ul, 1325354ul, 1800113ul, 2444937ul, 3320746ul,
+        4510281ul, 6125923ul, 8320308ul, 11300751ul, 15348827ul, 20846976ul, 28314633ul, 38457302ul,
+        52233206ul, 70943817ul, 96356811ul, 130873069ul, 177753497ul, 241427102ul, 327909416ul, 445370815ul,
+        604908408ul, 821594433ul, 1115900197ul, 1515630097ul, 2058548422ul, 2795947121ul, 3797491582ul, 5157802237ul,
+        7005393781ul, 9514816539ul, 12923147020ul, 17552385610ul, 23839877402ul, 32379630163ul, 43978432934ul, 59732077037ul,
+        81128880434ul, 110190295850ul, 149661886551ul, 203272712113ul, 276087629536ul, 374985793176ul, 509310559550ul, 691752196456ul,
+        939546789928ul, 1276104615187ul, 1733221811153ul, 2354084305397ul, 3197347783910ul, 4342679158872ul, 5898283061919ul, 8011124424756ul,
+        10880812920505ul, 14778460991715ul, 20072297068177ul, 27262453770999ul, 37028217701810ul, 50292204718239ul, 68307523624007ul, 92776163021386ul,
+        126009785867068ul, 171148122719886ul, 232455596277593ul, 315724200663364ul, 428820697289139ul, 582429823362227ul, 791063727301921ul, 1074432996992359ul,
+        1459308808107423ul, 1982052118076427ul, 2692048850075920ul, 3656375604405594ul, 4966136688089944ul, 6745071150534128ul, 9161242970794320ul, 12442918821291044ul,
+        16900133452067452ul, 22953980074914188ul, 31176392942335128ul, 42344180561397360ul, 57512414304395888ul, 78114105770082880ul, 106095589866296240ul, 0ul
+    },
+    { // 2^58 buckets, common ratio 1.366065
+        0ul, 1ul, 2ul, 3ul, 5ul, 7ul, 10ul, 14ul,
+        20ul, 28ul, 39ul, 54ul, 74ul, 102ul, 140ul, 192ul,
+        263ul, 360ul, 492ul, 673ul, 920ul, 1257ul, 1718ul, 2347ul,
+        3207ul, 4381ul, 5985ul, 8176ul, 11169ul, 15258ul, 20844ul, 28475ul,
+        38899ul, 53139ul, 72592ul, 99166ul, 135468ul, 185059ul, 252803ul, 345346ul,
+        471766ul, 644464ul, 880380ul, 1202657ul, 1642908ul, 2244320ul, 3065888ul, 4188203ul,
+        5721358ul, 7815748ul, 10676820ul, 14585231ul, 19924374ul, 27217991ul, 37181546ul, 50792410ul,
+        69385735ul, 94785426ul, 129483056ul, 176882275ul, 241632690ul, 330085967ul, 450918895ul, 615984532ul,
+        841474926ul, 1149509467ul, 1570304680ul, 2145138303ul, 2930398411ul, 4003114780ul, 5468515094ul, 7470347211ul,
+        10204980053ul, 13940666335ul, 19043856711ul, 26015146601ul, 35538381901ul, 48547740572ul, 66319370455ul, 90596572481ul,
+        123760809082ul, 169065312794ul, 230954210805ul, 315498469834ul, 430991425186ul, 588762312164ul, 804287602880ul, 1098709164601ul,
+        1500908162771ul, 2050338147394ul, 2800895233255ul, 3826205017763ul, 5226844854507ul, 7140209948566ul, 9753991084247ul, 13324586077567ul,
+        18202251017558ul, 24865458497356ul, 33967833192023ul, 46402268909853ul, 63388516653689ul, 86592835608127ul, 118291444168378ul, 161593804674150ul,
+        220747644875298ul, 301555637088022ul, 411944609016930ul, 562743122751101ul, 768743698235036ul, 1050153879601407ul, 1434578486137663ul, 1959727496002932ul,
+        2677115191466339ul, 3657113431840694ul, 4995854752900641ul, 6824662449564166ul, 9322932682029774ul, 12735732270423064ul, 17397838426586358ul, 23766578590894804ul,
+        32466691784768400ul, 44351612135327632ul, 60587186155054488ul, 82766035989553088ul, 113063787050498576ul, 154452485120998688ul, 210992137999035168ul, 0ul
+    },
+    { // 2^59 buckets, common ratio 1.374269
+        0ul, 1ul, 2ul, 3ul, 5ul, 7ul, 10ul, 14ul,
+        20ul, 28ul, 39ul, 54ul, 75ul, 104ul, 143ul, 197ul,
+        271ul, 373ul, 513ul, 706ul, 971ul, 1335ul, 1835ul, 2522ul,
+        3466ul, 4764ul, 6548ul, 8999ul, 12368ul, 16997ul, 23359ul, 32102ul,
+        44117ul, 60629ul, 83321ul, 114506ul, 157363ul, 216260ul, 297200ul, 408433ul,
+        561297ul, 771374ul, 1060076ul, 1456830ul, 2002077ul, 2751393ul, 3781155ul, 5196325ul,
+        7141149ul, 9813860ul, 13486884ul, 18534607ul, 25471536ul, 35004743ul, 48105934ul, 66110495ul,
+        90853605ul, 124857294ul, 171587510ul, 235807398ul, 324062800ul, 445349463ul, 612029966ul, 841093815ul,
+        1155889164ul, 1588502656ul, 2183029971ul, 3000070435ul, 4122903823ul, 5665978950ul, 7786579275ul, 10700854581ul,
+        14705852817ul, 20209797772ul, 27773698749ul, 38168533446ul, 52453832620ul, 72085676554ul, 99065111255ul, 136142112235ul,
+        187095885615ul, 257120077245ul, 353352153657ul, 485600913906ul, 667346286547ul, 917113319631ul, 1260360412577ul, 1732074254717ul,
+        2380335968915ul, 3271221952223ul, 4495538949312ul, 6178079855158ul, 8490343677825ul, 11668016189108ul, 16034993040960ul, 22036393989893ul,
+        30283933322414ul, 41618271024607ul, 57194700062151ul, 78600903753673ul, 108018786079492ul, 148446870059579ul, 204005932951966ul, 280359031233858ul,
+        385288727916037ul, 529490358151981ul, 727662189580095ul, 1000003595896484ul, 1374273950365571ul, 1888622099363825ul, 2595474820181661ul, 3566880608071984ul,
+        4901853477179751ul, 6736465318565072ul, 9257715515058414ul, 12722591523117836ul, 17484263239761964ul, 24028081109246832ul, 33021047205441448ul, 45379801807160248ul,
+        62364055241645816ul, 85704988371486928ul, 117781709404483920ul, 161863753018809440ul, 222444339395338432ul, 305698361777627264ul, 420111784581934208ul, 0ul
+    },
+    { // 2^60 buckets, common ratio 1.382625
+        0ul, 1ul, 2ul, 3ul, 5ul, 7ul, 10ul, 14ul,
+        20ul, 28ul, 39ul, 54ul, 75ul, 104ul, 144ul, 200ul,
+        277ul, 383ul, 530ul, 733ul, 1014ul, 1402ul, 1939ul, 2681ul,
+        3707ul, 5126ul, 7088ul, 9801ul, 13552ul, 18738ul, 25908ul, 35822ul,
+        49529ul, 68481ul, 94684ul, 130913ul, 181004ul, 250261ul, 346018ul, 478414ul,
+        661468ul, 914563ul, 1264498ul, 1748327ul, 2417281ul, 3342194ul, 4621001ul, 6389112ul,
+        8833746ul, 12213758ul, 16887047ul, 23348454ul, 32282156ul, 44634116ul, 61712244ul, 85324891ul,
+        117972327ul, 163111487ul, 225522018ul, 311812377ul, 431119583ul, 596076707ul, 824150548ul, 1139491139ul,
+        1575488918ul, 2178310340ul, 3011786299ul, 4164170983ul, 5757486838ul, 7960445147ul, 11006310343ul, 15217599660ul,
+        21040233484ul, 29090752480ul, 40221601177ul, 55611390676ul, 76889698132ul, 106309617634ul, 146986333358ul, 203226976777ul,
+        280986695472ul, 388499225272ul, 537148735044ul, 742675261082ul, 1026841370813ul, 1419736533673ul, 1962963201853ul, 2714041965138ul,
+        3752502228048ul, 5188303332218ul, 7173477810593ul, 9918229641572ul, 13713192097380ul, 18960202001316ul, 26214848984678ul, 36245305152434ul,
+        50113664448759ul, 69288404496000ul, 95799879142947ul, 132455306346866ul, 183136015790409ul, 253208430863129ul, 350092302617002ul, 484046364229974ul,
+        669254596495884ul, 925328125629856ul, 1279381784697132ul, 1768905219324942ul, 2445732550190837ul, 3381530927556257ul, 4675389143889524ul, 6464309839270678ul,
+        8937716286719235ul, 12357509836022784ul, 17085801836685326ul, 23623256487444112ul, 32662104617961236ul, 45159441867875480ul, 62438572580425536ul, 86329130401727792ul,
+        119360812522081024ul, 165031241478209472ul, 228176317573246400ul, 315482277385409600ul, 436193678655257088ul, 603092277878950784ul, 833850450924772864ul, 0ul
+    },
+    { // 2^61 buckets, common ratio 1.390555
+        0ul, 1ul, 2ul, 3ul, 5ul, 7ul, 10ul, 14ul,
+        20ul, 28ul, 39ul, 55ul, 77ul, 108ul, 151ul, 210ul,
+        293ul, 408ul, 568ul, 790ul, 1099ul, 1529ul, 2127ul, 2958ul,
+        4114ul, 5721ul, 7956ul, 11064ul, 15386ul, 21396ul, 29753ul, 41374ul,
+        57533ul, 80003ul, 111249ul, 154698ul, 215117ul, 299133ul, 415961ul, 578417ul,
+        804321ul, 1118453ul, 1555271ul, 2162690ul, 3007340ul, 4181872ul, 5815124ul, 8086250ul,
+        11244376ul, 15635924ul, 21742613ul, 30234300ul, 42042458ul, 58462352ul, 81295118ul, 113045335ul,
+        157195759ul, 218589353ul, 303960524ul, 422673834ul, 587751224ul, 817300418ul, 1136501203ul, 1580367458ul,
+        2197587909ul, 3055866908ul, 4249351083ul, 5908956498ul, 8216729146ul, 11425813997ul, 15888223059ul, 22093448400ul,
+        30722155674ul, 42720847926ul, 59405689720ul, 82606880304ul, 114869412436ul, 159732238584ul, 222116466882ul, 308865168969ul,
+        429494012494ul, 597235056915ul, 830488208990ul, 1154839551506ul, 1605867940431ul, 2233047732683ul, 3105175743843ul, 4317917731461ul,
+        6004302195337ul, 8349312584223ul, 11610178562166ul, 16144592130865ul, 22449943700379ul, 31217882004381ul, 43410182664422ul, 60364247603153ul,
+        83939807783420ul, 116722921439171ul, 162309644840359ul, 225700492100282ul, 313848953242505ul, 436424238754653ul, 606871917859828ul, 843888794393730ul,
+        1173473802865585ul, 1631779892279665ul, 2269079727511594ul, 3155280215281429ul, 4387590755951325ul, 6101186369589197ul, 8484035359489659ul, 11797517994179430ul,
+        16405097919271242ul, 22812191333266676ul, 31721607270277396ul, 44110640363703304ul, 61338272576090568ul, 85294243103182960ul, 118606338277949536ul, 164928639588085376ul,
+        229342348404947488ul, 318913154824179136ul, 443466289707343104ul, 616664277192389888ul, 857505608861876736ul, 1192408732637143808ul, 1658109954005377280ul, 0ul
+    },
+    { // 2^62 buckets, common ratio 1.398671
+        0ul, 1ul, 2ul, 3ul, 5ul, 7ul, 10ul, 14ul,
+        20ul, 28ul, 40ul, 56ul, 79ul, 111ul, 156ul, 219ul,
+        307ul, 430ul, 602ul, 842ul, 1178ul, 1648ul, 2306ul, 3226ul,
+        4513ul, 6313ul, 8830ul, 12351ul, 17275ul, 24163ul, 33797ul, 47271ul,
+        66117ul, 92476ul, 129344ul, 180910ul, 253034ul, 353912ul, 495007ul, 692352ul,
+        968373ul, 1354436ul, 1894411ul, 2649658ul, 3706000ul, 5183475ul, 7249977ul, 10140333ul,
+        14182991ul, 19837339ul, 27745912ul, 38807404ul, 54278792ul, 75918174ul, 106184551ul, 148517256ul,
+        207726784ul, 290541436ul, 406371890ul, 568380591ul, 794977468ul, 1111911955ul, 1555199041ul, 2175211847ul,
+        3042405797ul, 4255324853ul, 5951799600ul, 8324609683ul, 11643390408ul, 16285272867ul, 22777739391ul, 31858564238ul,
+        44559650889ul, 62324292850ul, 87171182937ul, 121923808312ul, 170531298675ul, 238517187336ul, 333607080323ul, 466606558984ul,
+        652629076925ul, 912813383883ul, 1276725636745ul, 1785719162649ul, 2497633662296ul, 3493367849500ul, 4886072411717ul, 6834007937629ul,
+        9558528927974ul, 13369237510516ul, 18699165212494ul, 26153980686566ul, 36580815131588ul, 51164526414854ul, 71562340911201ul, 100092173142917ul,
+        139996023004658ul, 195808381831577ul, 273871511294467ul, 383056149063276ul, 535769538940544ul, 749365333407417ul, 1048115583471285ul, 1465968903739094ul,
+        2050408238004104ul, 2867846604216465ul, 4011173966664216ul, 5610312827467499ul, 7846982026616562ul, 10975346441392366ul, 15350899122745016ul, 21470857902759596ul,
+        30030666959269260ul, 42003023917485616ul, 58748412767712920ul, 82169703055326608ul, 114928383289212080ul, 160747000346082016ul, 224832172703927360ul, 314466246797374208ul,
+        439834829622227200ul, 615184234616651392ul, 860440367685128832ul, 1203473016182655232ul, 1683262844322743808ul, 2354330977909905408ul, 3292934536184318464ul, 0ul
+    },
+    { // 2^63 buckets, common ratio 1.404869
+        0ul, 1ul, 2ul, 3ul, 5ul, 8ul, 12ul, 17ul,
+        24ul, 34ul, 48ul, 68ul, 96ul, 135ul, 190ul, 267ul,
+        376ul, 529ul, 744ul, 1046ul, 1470ul, 2066ul, 2903ul, 4079ul,
+        5731ul, 8052ul, 11313ul, 15894ul, 22329ul, 31370ul, 44071ul, 61914ul,
+        86982ul, 122199ul, 171674ul, 241180ul, 338827ul, 476008ul, 668729ul, 939477ul,
+        1319843ul, 1854207ul, 2604918ul, 3659569ul, 5141215ul, 7222734ul, 10146995ul, 14255199ul,
+        20026687ul, 28134871ul, 39525807ul, 55528580ul, 78010379ul, 109594361ul, 153965717ul, 216301657ul,
+        303875484ul, 426905236ul, 599745916ul, 842564422ul, 1183692604ul, 1662932998ul, 2336202953ul, 3282059014ul,
+        4610862835ul, 6477658078ul, 9100260770ul, 12784673888ul, 17960791514ul, 25232558502ul, 35448438231ul, 49800410565ul,
+        69963051017ul, 98288918748ul, 138083051099ul, 193988592444ul, 272528552193ul, 382866903794ul, 537877829098ul, 755647866577ul,
+        1061586232732ul, 1491389547133ul, 2095206882604ul, 2943491114947ul, 4135219302545ul, 5809441242512ul, 8161503678760ul, 11465843188322ul,
+        16108007199865ul, 22629639328677ul, 31791677877466ul, 44663141448470ul, 62745861094042ul, 88149712643370ul, 123838795159136ul, 173977279409996ul,
+        244415279654559ul, 343371439829423ul, 482391877697536ul, 677697375716961ul, 952076007676117ul, 1337542031107215ul, 1879071282706888ul, 2639848919417380ul,
+        3708641806983624ul, 5210155759800944ul, 7319586105692309ul, 10283059322719904ul, 14446350860241078ul, 20295229914319608ul, 28512138550414512ul, 40055818443547160ul,
+        56273176013978328ul, 79056438284069680ul, 111063936263530416ul, 156030276674318112ul, 219202092579339520ul, 307950215915178688ul, 432629699681724288ul, 607788036421615360ul,
+        853862546859373184ul, 1199564988514219776ul, 1685231618322883328ul, 2367529591633708032ul, 3326068836068645376ul, 4672690867881917440ul, 6564518361740979200ul, 0ul
+    },
+    { // 2^64 buckets, common ratio 1.412407
+        0ul, 1ul, 2ul, 3ul, 5ul, 8ul, 12ul, 17ul,
+        25ul, 36ul, 51ul, 73ul, 104ul, 147ul, 208ul, 294ul,
+        416ul, 588ul, 831ul, 1174ul, 1659ul, 2344ul, 3311ul, 4677ul,
+        6606ul, 9331ul, 13180ul, 18616ul, 26294ul, 37138ul, 52454ul, 74087ul,
+        104642ul, 147798ul, 208751ul, 294842ul, 416437ul, 588179ul, 830749ul, 1173356ul,
+        1657257ul, 2340722ul, 3306053ul, 4669493ul, 6595225ul, 9315143ul, 13156774ul, 18582721ul,
+        26246366ul, 37070553ul, 52358711ul, 73951813ul, 104450062ul, 147526003ul, 208366766ul, 294298688ul,
+        415669539ul, 587094584ul, 829216524ul, 1171191257ul, 1654198778ul, 2336402001ul, 3299950636ul, 4660873512ul,
+        6583050564ul, 9297946966ul, 13132485758ul, 18548415346ul, 26197912427ul, 37002115961ul, 52262049101ul, 73815286107ul,
+        104257229802ul, 147253645406ul, 207982085525ul, 293755361914ul, 414902141381ul, 586010705645ul, 827685646518ul, 1169029034543ul,
+        1651144839050ul, 2332088595718ul, 3293858351886ul, 4652268726930ul, 6570897104661ul, 9280781333656ul, 13108240897888ul, 18514171734006ul,
+        26149546507914ul, 36933803596171ul, 52165564235223ul, 73679010202493ul, 104064752754147ul, 146981789467841ul, 207598114283779ul, 293213038228865ul,
+        414136159588996ul, 584928827568890ul, 826157594305869ul, 1166870802839470ul, 1648096537396384ul, 2327783153000555ul, 3287777314278759ul, 4643679826599154ul,
+        6558766081362296ul, 9263647390938398ul, 13084040796560236ul, 18479991340507084ul, 26101269879485472ul, 36865617346281808ul, 52069257495806760ul, 73542985885683952ul,
+        103872631051392880ul, 146710435422218848ul, 207214851919247904ul, 292671715766804992ul, 413371591932349120ul, 583848946827629952ul, 824632363143908992ul, 1164716555607781376ul,
+        1645053863439162624ul, 2323485658881137664ul, 3281707503327574016ul, 4635106782876613632ul, 6546657454049243136ul, 9246545080469489664ul, 13059885372843491328ul, 0ul
+    }
+};
+
+#endif
@@ -7,19 +7,28 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <pthread.h>
 #include "geoseq_unordered_flatmap56.h"
+#include "geoseq_unordered_flatmap56_core.h"
 
 #define SAMPLE_SIZE 10000
 int samples[SAMPLE_SIZE];
+uint64_t batch_keys[SAMPLE_SIZE];
+void* batch_values[SAMPLE_SIZE];
 
-int main(){
+FLATMAP56_DEFINE(intmap, int)
+
+// the tests are linked with --wrap=realloc, and reallocs of more than this many bytes fail
+static size_t realloc_limit = SIZE_MAX;
+void* __real_realloc(void* p, size_t size);
+void* __wrap_realloc(void* p, size_t size){
+    return size > realloc_limit ? NULL : __real_realloc(p, size);
+}
+
+static int test_map(flatmap56_t* map){
 
     int i,j,buff,*value;
     int r = EXIT_SUCCESS;
-    flatmap56_t* map = flatmap56_create(0,sizeof(int));
-
-    srand(time(0));
-    //srand(0);
 
     fprintf(stdout, "\n               Buckets\tCount\tLoad Factor\n");
     fprintf(stdout, "               -------\t-----\t-----------");
@@ -65,6 +74,16 @@ int main(){
         }
 
         fprintf(stdout, "After Insert:  %ld,\t%ld,\t%f\n", flatmap56_bucket_count(map), flatmap56_size(map), flatmap56_load_factor(map));
+
+        for(i = 0; i < SAMPLE_SIZE; i++) batch_keys[i] = samples[i];
+        flatmap56_lookup_batch(map, batch_keys, SAMPLE_SIZE, batch_values);
+        for(i = 0; i < SAMPLE_SIZE; i++){
+            if(batch_values[i] != flatmap56_lookup(map, samples[i])){
+                fprintf(stderr, "Batch lookup failed [%d] %d\n", i, samples[i]);
+                r = EXIT_FAILURE;
+                goto end_test;
+            }
+        }
         
         for(i = 0; i < SAMPLE_SIZE; i++){
             if(!flatmap56_remove(map, samples[i], &buff)){
@@ -105,7 +124,1049 @@ int main(){
 
     fprintf(stdout, "\nEnd State:     %ld,\t%ld,\t%f\n\n", flatmap56_bucket_count(map), flatmap56_size(map), flatmap56_load_factor(map));
 
+    return r;
+}
+
+// checks that the occupancy bitmap of a map, if it has one, agrees with its buckets
+static int check_occupancy(const flatmap56_t* map){
+    for(uint64_t i = 0; map->occupancy && i < map->num_buckets; i++){
+        bool occupied = FLATMAP56_BUCKET_AT(map,i,map->bucket_size)->next_probe != FLATMAP56_EMPTY_SLOT;
+        if(occupied != !FLATMAP56_IS_EMPTY(map,i,map->bucket_size,true)){
+            fprintf(stderr, "Occupancy bitmap is wrong at bucket %ld\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+    return map->migrating ? check_occupancy(map->migrating) : EXIT_SUCCESS;
+}
+
+// removes and reinserts every third sample so that new entries land in the gaps of existing chains
+static int test_churn(flatmap56_t* map){
+
+    int i,*value;
+
+    for(i = 0; i < SAMPLE_SIZE; i++){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value) return EXIT_FAILURE;
+        *value = samples[i];
+    }
+    for(i = 0; i < SAMPLE_SIZE; i += 3) flatmap56_remove(map, samples[i], NULL);
+    for(i = 0; i < SAMPLE_SIZE; i += 3){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value) return EXIT_FAILURE;
+        *value = samples[i];
+    }
+    for(i = 0; i < SAMPLE_SIZE; i++){
+        value = (int*)flatmap56_lookup(map, samples[i]);
+        if(!value || *value != samples[i]){
+            fprintf(stderr, "Lookup failed after churn [%d] %d\n", i, samples[i]);
+            return EXIT_FAILURE;
+        }
+    }
+    if(check_occupancy(map) != EXIT_SUCCESS) return EXIT_FAILURE;
+    return flatmap56_size(map) == SAMPLE_SIZE ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// batches keys that live down their chains back to back, so that more walks are in flight than the
+// batch can hold, and checks every result, including misses, against flatmap56_lookup()
+static int test_lookup_batch(const uint64_t flags){
+
+    int i,*value;
+    int r = EXIT_SUCCESS;
+    uint64_t n = 0, chained;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value) r = EXIT_FAILURE;
+        else *value = samples[i];
+    }
+    for(i = 0; i < SAMPLE_SIZE; i++){
+        uint64_t key = samples[i];
+        if(flatmap56_lookup(map, key) != FLATMAP56_VALUE_AT(map,FLATMAP56_HASH(map,key),map->value_stride)) batch_keys[n++] = key;
+    }
+    chained = n;
+    // then misses, which walk to the end of the chain of their home bucket, mixed with keys at home
+    for(i = 0; n < SAMPLE_SIZE; i++) batch_keys[n++] = i % 2 ? samples[i] + (1ul << 40) : (uint64_t)samples[i];
+    flatmap56_lookup_batch(map, batch_keys, SAMPLE_SIZE, batch_values);
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        if(batch_values[i] != flatmap56_lookup(map, batch_keys[i])){
+            fprintf(stderr, "Chained batch lookup failed [%d] %lu\n", i, batch_keys[i]);
+            r = EXIT_FAILURE;
+        }
+    }
+    if(chained < SAMPLE_SIZE / 10){
+        fprintf(stderr, "Only %lu keys live down their chains\n", chained);
+        r = EXIT_FAILURE;
+    }
+
+    flatmap56_destroy(map);
+    return r;
+}
+
+#define SPILL_CLUSTERS 4
+#define SPILL_CLUSTER_SIZE 125
+#define CLUSTER_STRIDE 12586269025ul // F(50): keys this far apart hash to nearly the same point
+
+// grows in place a map of keys that crowd a few homes at every table size, so that the rehash runs
+// out of room along some probe sequences and has to park entries, and checks that every key survives
+static int test_inplace_spill(const uint64_t flags){
+
+    int i,j,*value;
+    int r = EXIT_SUCCESS;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < SPILL_CLUSTERS; i++){
+        for(j = 0; j < SPILL_CLUSTER_SIZE && r == EXIT_SUCCESS; j++){
+            value = (int*)flatmap56_insert(map, samples[i] + j * CLUSTER_STRIDE);
+            if(!value) r = EXIT_FAILURE;
+            else *value = i * SPILL_CLUSTER_SIZE + j;
+        }
+    }
+    for(i = 0; i < SPILL_CLUSTERS; i++){
+        for(j = 0; j < SPILL_CLUSTER_SIZE && r == EXIT_SUCCESS; j++){
+            value = (int*)flatmap56_lookup(map, samples[i] + j * CLUSTER_STRIDE);
+            if(!value || *value != i * SPILL_CLUSTER_SIZE + j){
+                fprintf(stderr, "Lookup failed after in-place growth [%d] %lu\n", j, samples[i] + j * CLUSTER_STRIDE);
+                r = EXIT_FAILURE;
+            }
+        }
+    }
+    if(flatmap56_size(map) != SPILL_CLUSTERS * SPILL_CLUSTER_SIZE || check_occupancy(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    flatmap56_destroy(map);
+    return r;
+}
+
+// clusters like those of test_inplace_spill, but fixed, so that the growths that run out of room do
+// not depend on the samples
+#define OOM_CLUSTERS 4
+#define OOM_KEY(I,J) ((I) * 1000003ul + 1 + (J) * CLUSTER_STRIDE)
+
+// inserts clustered keys with enough memory for a single doubling of the table, so that the entries
+// an in-place growth cannot place even then have to wait in the table it reserved beforehand; checks
+// that no key is lost while memory is short and that the map recovers afterwards
+static int test_inplace_oom(const uint64_t flags){
+
+    int i,j,*value;
+    int r = EXIT_SUCCESS;
+    uint64_t inserted = 0;
+    bool spilled = false;
+    bool present[OOM_CLUSTERS][SPILL_CLUSTER_SIZE] = {{false}};
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < OOM_CLUSTERS; i++){
+        for(j = 0; j < SPILL_CLUSTER_SIZE; j++){
+            realloc_limit = 2 * flatmap56_bucket_count(map) * (map->bucket_size > map->value_stride ? map->bucket_size : map->value_stride);
+            value = (int*)flatmap56_insert(map, OOM_KEY(i,j));
+            if(value){
+                *value = i * SPILL_CLUSTER_SIZE + j;
+                present[i][j] = true;
+                inserted++;
+            }
+            if(map->migrating) spilled = true;
+        }
+    }
+    realloc_limit = SIZE_MAX;
+    if(!spilled || flatmap56_size(map) != inserted) r = EXIT_FAILURE;
+    for(i = 0; i < OOM_CLUSTERS; i++){
+        for(j = 0; j < SPILL_CLUSTER_SIZE && r == EXIT_SUCCESS; j++){
+            value = (int*)flatmap56_lookup(map, OOM_KEY(i,j));
+            if(!value != !present[i][j] || (value && *value != i * SPILL_CLUSTER_SIZE + j)){
+                fprintf(stderr, "Lookup failed after a failed in-place growth [%d] %lu\n", j, OOM_KEY(i,j));
+                r = EXIT_FAILURE;
+            }
+        }
+    }
+    // with memory back, the inserts that failed succeed and the waiting entries move back in
+    for(i = 0; i < OOM_CLUSTERS; i++){
+        for(j = 0; j < SPILL_CLUSTER_SIZE && r == EXIT_SUCCESS; j++){
+            value = (int*)flatmap56_insert(map, OOM_KEY(i,j));
+            if(!value) r = EXIT_FAILURE;
+            else *value = i * SPILL_CLUSTER_SIZE + j;
+        }
+    }
+    for(i = 0; i < OOM_CLUSTERS; i++){
+        for(j = 0; j < SPILL_CLUSTER_SIZE && r == EXIT_SUCCESS; j++){
+            value = (int*)flatmap56_lookup(map, OOM_KEY(i,j));
+            if(!value || *value != i * SPILL_CLUSTER_SIZE + j) r = EXIT_FAILURE;
+        }
+    }
+    if(flatmap56_size(map) != OOM_CLUSTERS * SPILL_CLUSTER_SIZE || check_occupancy(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(r != EXIT_SUCCESS) fprintf(stderr, "In-place growth without memory failed (%ld inserted, %s)\n", inserted, spilled ? "spilled" : "never spilled");
+
+    flatmap56_destroy(map);
+    return r;
+}
+
+#define MIGRATION_BOUND 8 // old home buckets an insert or remove may move (MIGRATION_STEP)
+
+// checks that a growth or shrink keeps both tables alive, moves a bounded number of old buckets per
+// call, and that every key stays reachable until the old table is gone; a plain map resizes at once
+static int test_incremental(const uint64_t flags){
+
+    int i,j,*value;
+    int r = EXIT_SUCCESS;
+    int migrations = 0;
+    uint64_t buckets, index;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+    bool incremental = flags & FLATMAP56_INCREMENTAL_RESIZE;
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < 2 * SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        const int k = i % SAMPLE_SIZE, removing = i >= SAMPLE_SIZE;
+        buckets = flatmap56_bucket_count(map);
+        index = map->migrating ? map->migrate_index : 0;
+        if(removing){
+            if(!flatmap56_remove(map, samples[k], NULL)) r = EXIT_FAILURE;
+        }
+        else{
+            value = (int*)flatmap56_insert(map, samples[k]);
+            if(!value) r = EXIT_FAILURE;
+            else *value = samples[k];
+        }
+        if(flatmap56_size(map) != (uint64_t)(removing ? SAMPLE_SIZE - k - 1 : k + 1)) r = EXIT_FAILURE;
+        if(flatmap56_bucket_count(map) != buckets){
+            // a resize has just started: the old table keeps the entries that have not moved yet
+            migrations++;
+            if(!incremental != !map->migrating) r = EXIT_FAILURE;
+            if(map->migrating && (map->migrating->num_buckets != buckets || map->migrate_index > MIGRATION_BOUND || map->migrating->num_entries == 0)) r = EXIT_FAILURE;
+        }
+        else if(map->migrating && map->migrate_index - index > MIGRATION_BOUND) r = EXIT_FAILURE;
+        // every key that should be present is found in one of the two tables
+        for(j = removing ? k + 1 : 0; j < (removing ? SAMPLE_SIZE : k + 1) && map->migrating && r == EXIT_SUCCESS; j++){
+            value = (int*)flatmap56_lookup(map, samples[j]);
+            if(!value || *value != samples[j]) r = EXIT_FAILURE;
+        }
+        if(r != EXIT_SUCCESS) fprintf(stderr, "Incremental resize failed at [%d] %d\n", i, samples[k]);
+    }
+    if(r == EXIT_SUCCESS && (migrations < 2 || flatmap56_size(map) != 0)) r = EXIT_FAILURE;
+
     flatmap56_destroy(map);
+    return r;
+}
+
+// exercises the functions generated by FLATMAP56_DEFINE()
+static int test_typed(){
+
+    int i,buff,*value;
+    int r = EXIT_SUCCESS;
+    flatmap56_t* map = intmap_create(0);
+
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = intmap_insert(map, samples[i]);
+        if(!value) r = EXIT_FAILURE;
+        else *value = samples[i];
+    }
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = intmap_lookup(map, samples[i]);
+        if(!value || *value != samples[i] || value != flatmap56_lookup(map, samples[i])){
+            fprintf(stderr, "Typed lookup failed [%d] %d\n", i, samples[i]);
+            r = EXIT_FAILURE;
+        }
+    }
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        bool inserted;
+        value = intmap_try_emplace(map, samples[i], &inserted);
+        if(!value || inserted || *value != samples[i]) r = EXIT_FAILURE;
+    }
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        if(!intmap_remove(map, samples[i], &buff) || buff != samples[i] || intmap_lookup(map, samples[i])){
+            fprintf(stderr, "Typed removal failed [%d] %d\n", i, samples[i]);
+            r = EXIT_FAILURE;
+        }
+    }
+    if(r == EXIT_SUCCESS && flatmap56_size(map) != 0) r = EXIT_FAILURE;
+
+    intmap_destroy(map);
+    return r;
+}
+
+// checks that a map honors the maximum load factor of its policy and, if set, never shrinks
+static int test_policy(const uint64_t flags, const flatmap56_policy_t* policy){
+
+    int i,*value;
+    int r = EXIT_SUCCESS;
+    uint64_t buckets;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,policy);
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value || flatmap56_load_factor(map) > policy->max_load_factor){
+            fprintf(stderr, "Policy insertion failed [%d] %d (load factor %f)\n", i, samples[i], flatmap56_load_factor(map));
+            r = EXIT_FAILURE;
+        }
+        else *value = samples[i];
+    }
+    buckets = flatmap56_bucket_count(map);
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        if(!flatmap56_remove(map, samples[i], NULL)) r = EXIT_FAILURE;
+        for(int j = i + 1; j < SAMPLE_SIZE && r == EXIT_SUCCESS && (i % 1000) == 0; j++){
+            value = (int*)flatmap56_lookup(map, samples[j]);
+            if(!value || *value != samples[j]) r = EXIT_FAILURE;
+        }
+    }
+    if(r == EXIT_SUCCESS && flatmap56_size(map) != 0) r = EXIT_FAILURE;
+    if(r == EXIT_SUCCESS && policy->never_shrink && flatmap56_bucket_count(map) != buckets) r = EXIT_FAILURE;
+    if(r == EXIT_SUCCESS && !policy->never_shrink && flatmap56_bucket_count(map) >= buckets) r = EXIT_FAILURE;
+
+    flatmap56_destroy(map);
+    return r;
+}
+
+// checks that a reserved table neither grows nor shrinks below its floor, and that shrink_to_fit keeps every entry
+static int test_reserve(const uint64_t flags){
+
+    int i,*value;
+    int r = EXIT_SUCCESS;
+    uint64_t buckets;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map || !flatmap56_reserve(map, SAMPLE_SIZE)) return EXIT_FAILURE;
+    buckets = flatmap56_bucket_count(map);
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value || flatmap56_bucket_count(map) != buckets) r = EXIT_FAILURE;
+        else *value = samples[i];
+    }
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i += 2){
+        if(!flatmap56_remove(map, samples[i], NULL)) r = EXIT_FAILURE;
+    }
+    if(r == EXIT_SUCCESS && (!flatmap56_shrink_to_fit(map) || flatmap56_bucket_count(map) != buckets)) r = EXIT_FAILURE;
+    if(r == EXIT_SUCCESS && (!flatmap56_reserve(map, 0) || !flatmap56_shrink_to_fit(map) || flatmap56_bucket_count(map) >= buckets)) r = EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_lookup(map, samples[i]);
+        if((i % 2 == 0) != (value == NULL) || (value && *value != samples[i])){
+            fprintf(stderr, "Lookup failed after shrink_to_fit [%d] %d\n", i, samples[i]);
+            r = EXIT_FAILURE;
+        }
+    }
+    if(r == EXIT_SUCCESS && flatmap56_size(map) != SAMPLE_SIZE / 2) r = EXIT_FAILURE;
+
+    flatmap56_destroy(map);
+    return r;
+}
+
+static void count_init(void* value, uint64_t key, void* ctx){
+    *(int*)value = (int)key;
+    (*(int*)ctx)++;
+}
+
+// checks that try_emplace and upsert report new keys exactly once
+static int test_try_emplace(const uint64_t flags){
+
+    int i,*value,calls = 0;
+    bool inserted;
+    int r = EXIT_SUCCESS;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_try_emplace(map, samples[i], &inserted);
+        if(!value || !inserted || *value != 0) r = EXIT_FAILURE;
+        else *value = samples[i];
+        // revisit an earlier key so that updates are interleaved with growth
+        value = (int*)flatmap56_try_emplace(map, samples[i / 2], &inserted);
+        if(!value || inserted || *value != samples[i / 2]) r = EXIT_FAILURE;
+    }
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i += 2) flatmap56_remove(map, samples[i], NULL);
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_upsert(map, samples[i], count_init, &calls);
+        if(!value || *value != samples[i]) r = EXIT_FAILURE;
+    }
+    if(r != EXIT_SUCCESS || calls != SAMPLE_SIZE / 2 || flatmap56_size(map) != SAMPLE_SIZE){
+        fprintf(stderr, "try_emplace/upsert failed (%d init calls)\n", calls);
+        r = EXIT_FAILURE;
+    }
+
+    flatmap56_destroy(map);
+    return r;
+}
+
+// builds a map from arrays that repeat part of the samples and checks that the last occurrence wins
+static int test_build(const uint64_t flags, const uint64_t nthreads){
+
+    int i,*value;
+    int r = EXIT_SUCCESS;
+    int n = SAMPLE_SIZE + SAMPLE_SIZE / 4;
+    uint64_t* build_keys = (uint64_t*)malloc(n * sizeof(uint64_t));
+    int* build_values = (int*)malloc(n * sizeof(int));
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map || !build_keys || !build_values || !flatmap56_insert(map, 1ul << 40)) r = EXIT_FAILURE;
+    for(i = 0; i < n && r == EXIT_SUCCESS; i++){
+        build_keys[i] = samples[i % SAMPLE_SIZE];
+        build_values[i] = i;
+    }
+    if(r == EXIT_SUCCESS && !flatmap56_build(map, build_keys, build_values, n, nthreads)) r = EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_lookup(map, samples[i]);
+        if(!value || *value != (i < SAMPLE_SIZE / 4 ? i + SAMPLE_SIZE : i)){
+            fprintf(stderr, "Lookup failed after build [%d] %d\n", i, samples[i]);
+            r = EXIT_FAILURE;
+        }
+    }
+    if(r == EXIT_SUCCESS && (flatmap56_size(map) != SAMPLE_SIZE || flatmap56_lookup(map, 1ul << 40))) r = EXIT_FAILURE;
+    // the map must keep working normally afterwards
+    if(r == EXIT_SUCCESS && test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    flatmap56_destroy(map);
+    free(build_values);
+    free(build_keys);
+    return r;
+}
+
+// removes most of the samples in one batch and checks the values, the survivors and the single shrink
+static int test_remove_batch(const uint64_t flags){
+
+    int i,*value;
+    int r = EXIT_SUCCESS;
+    int* removed_values = (int*)calloc(SAMPLE_SIZE, sizeof(int));
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map || !removed_values) r = EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value) r = EXIT_FAILURE;
+        else *value = samples[i];
+        batch_keys[i] = samples[i];
+    }
+    // the last key is not in the table
+    batch_keys[SAMPLE_SIZE - 1] = 1ul << 40;
+    if(r == EXIT_SUCCESS && flatmap56_remove_batch(map, batch_keys + SAMPLE_SIZE / 10, SAMPLE_SIZE - SAMPLE_SIZE / 10, removed_values) != SAMPLE_SIZE - SAMPLE_SIZE / 10 - 1) r = EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_lookup(map, samples[i]);
+        if(i < SAMPLE_SIZE / 10 || i == SAMPLE_SIZE - 1){
+            if(!value || *value != samples[i]) r = EXIT_FAILURE;
+        }
+        else if(value || removed_values[i - SAMPLE_SIZE / 10] != samples[i]) r = EXIT_FAILURE;
+    }
+    if(r == EXIT_SUCCESS && (flatmap56_size(map) != SAMPLE_SIZE / 10 + 1 || (!(flags & FLATMAP56_INCREMENTAL_RESIZE) && flatmap56_load_factor(map) < 0.375f / 2))){
+        fprintf(stderr, "Batch removal failed (size %ld, load factor %f)\n", flatmap56_size(map), flatmap56_load_factor(map));
+        r = EXIT_FAILURE;
+    }
+
+    flatmap56_destroy(map);
+    free(removed_values);
+    return r;
+}
+
+static bool is_odd(uint64_t key, void* value, void* ctx){
+    (void)key;
+    (*(int*)ctx)++;
+    return *(int*)value & 1;
+}
+
+// erases the odd samples with a sweep and checks that the predicate saw every entry exactly once
+static int test_erase_if(const uint64_t flags){
+
+    int i,*value,calls = 0,odd = 0;
+    int r = EXIT_SUCCESS;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value) r = EXIT_FAILURE;
+        else *value = samples[i];
+        odd += samples[i] & 1;
+    }
+    if(r == EXIT_SUCCESS && (flatmap56_erase_if(map, is_odd, &calls) != (uint64_t)odd || calls != SAMPLE_SIZE)) r = EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_lookup(map, samples[i]);
+        if((samples[i] & 1) != (value == NULL) || (value && *value != samples[i])){
+            fprintf(stderr, "Lookup failed after erase_if [%d] %d\n", i, samples[i]);
+            r = EXIT_FAILURE;
+        }
+    }
+    if(r == EXIT_SUCCESS && (flatmap56_size(map) != (uint64_t)(SAMPLE_SIZE - odd) || check_occupancy(map) != EXIT_SUCCESS)) r = EXIT_FAILURE;
+    if(r == EXIT_SUCCESS && test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    flatmap56_destroy(map);
+    return r;
+}
+
+// iterates over a map and checks that every entry is visited exactly once
+static int test_iter(const uint64_t flags){
+
+    int i,*value;
+    int r = EXIT_SUCCESS;
+    uint64_t key, visited = 0;
+    void* v;
+    flatmap56_iter_t iter;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value) r = EXIT_FAILURE;
+        else *value = samples[i] + 1;
+    }
+    // mark every visited entry by negating its value
+    for(flatmap56_iter_begin(map, &iter); r == EXIT_SUCCESS && flatmap56_iter_next(&iter, &key, &v); visited++){
+        if(*(int*)v != (int)key + 1 || flatmap56_lookup(map, key) != v) r = EXIT_FAILURE;
+        *(int*)v = -*(int*)v;
+    }
+    if(r == EXIT_SUCCESS && (visited != SAMPLE_SIZE || flatmap56_iter_next(&iter, &key, &v))) r = EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_lookup(map, samples[i]);
+        if(!value || *value != -(samples[i] + 1)) r = EXIT_FAILURE;
+    }
+    if(r != EXIT_SUCCESS) fprintf(stderr, "Iteration failed (%ld entries visited)\n", visited);
+
+    flatmap56_destroy(map);
+    return r;
+}
+
+static void count_visit(uint64_t key, void* value, void* ctx){
+    (void)key;
+    ((int*)ctx)[*(int*)value]++;
+}
+
+// scans a map in small steps while it grows and shrinks underneath, and checks that every key
+// that stayed in the map for the whole scan was visited
+static int test_scan(const uint64_t flags){
+
+    int i,*value,steps = 0;
+    int r = EXIT_SUCCESS;
+    int stable = SAMPLE_SIZE / 10;
+    int* seen = (int*)calloc(SAMPLE_SIZE, sizeof(int));
+    uint64_t cursor = 0;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map || !seen) r = EXIT_FAILURE;
+    for(i = 0; i < stable && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value) r = EXIT_FAILURE;
+        else *value = i;
+    }
+    do{
+        cursor = flatmap56_scan(map, cursor, 5, count_visit, seen);
+        // insert the other samples early in the scan and remove them again later on
+        for(i = stable + steps * 100; i < stable + (steps + 1) * 100 && i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+            value = (int*)flatmap56_insert(map, samples[i]);
+            if(!value) r = EXIT_FAILURE;
+            else *value = i;
+        }
+        for(i = stable + (steps - 100) * 100; steps >= 100 && i < stable + (steps - 99) * 100 && i < SAMPLE_SIZE; i++){
+            flatmap56_remove(map, samples[i], NULL);
+        }
+        steps++;
+    }while(cursor && r == EXIT_SUCCESS);
+    if(steps < 200) r = EXIT_FAILURE; // the scan must outlast the growth and the shrinking
+    // a count of 0 must not return the cursor it was given, which would end or stall the scan
+    if(flatmap56_scan(map, 0, 0, count_visit, seen) == 0) r = EXIT_FAILURE;
+    for(i = 0; i < stable && r == EXIT_SUCCESS; i++){
+        if(!seen[i]){
+            fprintf(stderr, "Scan missed [%d] %d after %d steps\n", i, samples[i], steps);
+            r = EXIT_FAILURE;
+        }
+    }
+
+    flatmap56_destroy(map);
+    free(seen);
+    return r;
+}
+
+#define MAX_TEST_THREADS 8
+
+static void sum_values(uint64_t key, void* value, void* ctx, uint64_t thread){
+    ((int64_t*)ctx)[thread] += *(int*)value - (int64_t)key;
+    ((int64_t*)ctx)[MAX_TEST_THREADS + thread]++;
+}
+
+// sums the values of a map on several threads
+static int test_for_each(const uint64_t flags, const uint64_t nthreads){
+
+    int i,*value;
+    int64_t sums[2 * MAX_TEST_THREADS] = {0}, sum = 0, count = 0;
+    int r = EXIT_SUCCESS;
+    flatmap56_t* map = flatmap56_create_ex(0,sizeof(int),flags,NULL);
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        value = (int*)flatmap56_insert(map, samples[i]);
+        if(!value) r = EXIT_FAILURE;
+        else *value = samples[i] + i % 7;
+    }
+    flatmap56_parallel_for_each(map, sum_values, sums, nthreads);
+    for(i = 0; i < MAX_TEST_THREADS; i++){
+        sum += sums[i];
+        count += sums[MAX_TEST_THREADS + i];
+    }
+    for(i = 0; i < SAMPLE_SIZE; i++) sum -= i % 7;
+    if(r == EXIT_SUCCESS && (sum != 0 || count != SAMPLE_SIZE)){
+        fprintf(stderr, "Parallel for_each failed (%ld entries visited)\n", count);
+        r = EXIT_FAILURE;
+    }
+
+    flatmap56_destroy(map);
+    return r;
+}
+
+#define SHARDED_BATCH 100
+
+typedef struct {
+    flatmap56_sharded_t* map;
+    int                  t;
+    int                  errors;
+}sharded_task_t;
+
+// the distinct key of sample i; the value stored with it is i
+static uint64_t sharded_key(const uint64_t i){
+    return i * 0x9e3779b97ul % (1ul << 48) + 1;
+}
+
+// inserts the keys of one thread singly and in batches while the other threads do the same
+static void* sharded_worker(void* arg){
+    sharded_task_t* task = (sharded_task_t*)arg;
+    uint64_t keys[SHARDED_BATCH];
+    int values[SHARDED_BATCH], value;
+    for(int i = task->t * SAMPLE_SIZE; i < (task->t + 1) * SAMPLE_SIZE; i += 2 * SHARDED_BATCH){
+        for(int j = 0; j < SHARDED_BATCH; j++){
+            value = i + j;
+            if(!flatmap56_sharded_insert(task->map, sharded_key(i + j), &value)) task->errors++;
+            keys[j] = sharded_key(i + SHARDED_BATCH + j);
+            values[j] = i + SHARDED_BATCH + j;
+        }
+        if(!flatmap56_sharded_insert_batch(task->map, keys, values, SHARDED_BATCH)) task->errors++;
+        for(int j = 0; j < 2 * SHARDED_BATCH; j++){
+            if(!flatmap56_sharded_lookup(task->map, sharded_key(i + j), &value) || value != i + j) task->errors++;
+        }
+    }
+    return NULL;
+}
+
+// fills a sharded map from several threads at once, then looks up and removes the keys in batches
+static int test_sharded(const uint64_t shard_bits, const uint64_t flags){
+
+    int i, nthreads = MAX_TEST_THREADS;
+    int r = EXIT_SUCCESS;
+    sharded_task_t tasks[MAX_TEST_THREADS];
+    pthread_t threads[MAX_TEST_THREADS];
+    uint64_t* keys = (uint64_t*)malloc(nthreads * SAMPLE_SIZE * sizeof(uint64_t));
+    int* values = (int*)malloc(nthreads * SAMPLE_SIZE * sizeof(int));
+    flatmap56_sharded_t* map = flatmap56_sharded_create(shard_bits, 0, sizeof(int), flags, NULL);
+
+    if(!map || !keys || !values) r = EXIT_FAILURE;
+    for(i = 0; i < nthreads && r == EXIT_SUCCESS; i++){
+        tasks[i].map = map;
+        tasks[i].t = i;
+        tasks[i].errors = 0;
+        if(pthread_create(&threads[i], NULL, sharded_worker, &tasks[i]) != 0) r = EXIT_FAILURE;
+    }
+    for(i = 0; i < nthreads && r == EXIT_SUCCESS; i++){
+        pthread_join(threads[i], NULL);
+        if(tasks[i].errors) r = EXIT_FAILURE;
+    }
+    if(r == EXIT_SUCCESS && flatmap56_sharded_size(map) != (uint64_t)nthreads * SAMPLE_SIZE) r = EXIT_FAILURE;
+    for(i = 0; i < nthreads * SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        keys[i] = sharded_key(i);
+        values[i] = -1;
+    }
+    if(r == EXIT_SUCCESS && flatmap56_sharded_lookup_batch(map, keys, nthreads * SAMPLE_SIZE, values) != (uint64_t)nthreads * SAMPLE_SIZE) r = EXIT_FAILURE;
+    for(i = 0; i < nthreads * SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        if(values[i] != i) r = EXIT_FAILURE;
+        values[i] = -1;
+    }
+    // remove the first half of the keys, then try to remove all of them
+    if(r == EXIT_SUCCESS && flatmap56_sharded_remove_batch(map, keys, nthreads * SAMPLE_SIZE / 2, values) != (uint64_t)nthreads * SAMPLE_SIZE / 2) r = EXIT_FAILURE;
+    if(r == EXIT_SUCCESS && flatmap56_sharded_remove_batch(map, keys, nthreads * SAMPLE_SIZE, NULL) != (uint64_t)nthreads * SAMPLE_SIZE / 2) r = EXIT_FAILURE;
+    for(i = 0; i < nthreads * SAMPLE_SIZE && r == EXIT_SUCCESS; i++){
+        if(values[i] != (i < nthreads * SAMPLE_SIZE / 2 ? i : -1)) r = EXIT_FAILURE;
+    }
+    if(r == EXIT_SUCCESS && (flatmap56_sharded_size(map) != 0 || flatmap56_sharded_lookup(map, keys[0], NULL))) r = EXIT_FAILURE;
+    if(r != EXIT_SUCCESS) fprintf(stderr, "Sharded map with %lu shard bits failed\n", shard_bits);
+
+    flatmap56_sharded_destroy(map);
+    free(keys);
+    free(values);
+    return r;
+}
+
+#define CONCURRENT_STABLE 2000  // keys that are present the whole time
+#define CONCURRENT_ROUNDS 20    // times the writer inserts and removes the other samples
+
+// a value that a reader can check for tearing: check == ~tagged and tagged holds the key
+typedef struct {
+    uint64_t tagged;
+    uint64_t check;
+}concurrent_value_t;
+
+typedef struct {
+    flatmap56_t* map;
+    bool         done;
+    uint64_t     errors;
+    uint64_t     reads;
+}concurrent_test_t;
+
+static concurrent_value_t concurrent_value(const uint64_t key, const uint64_t generation){
+    concurrent_value_t value;
+    value.tagged = key | generation << 40;
+    value.check = ~value.tagged;
+    return value;
+}
+
+static uint64_t concurrent_key(const uint64_t i){
+    return i * 0x9e3779b97ul % (1ul << 40) + 1;
+}
+
+// reads the stable keys, which must always be found, and the churned keys, which may be missing
+static void* concurrent_reader(void* arg){
+    concurrent_test_t* test = (concurrent_test_t*)arg;
+    concurrent_value_t value;
+    uint64_t errors = 0, reads = 0;
+    while(!__atomic_load_n(&test->done, __ATOMIC_ACQUIRE)){
+        for(uint64_t i = 0; i < SAMPLE_SIZE; i++, reads++){
+            uint64_t key = concurrent_key(i);
+            bool found = flatmap56_read(test->map, key, &value);
+            if(i < CONCURRENT_STABLE && !found) errors++;
+            if(found && (value.check != ~value.tagged || (value.tagged & ((1ul << 40) - 1)) != key)) errors++;
+        }
+    }
+    __atomic_fetch_add(&test->errors, errors, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&test->reads, reads, __ATOMIC_RELAXED);
+    return NULL;
+}
+
+// one writer grows, churns and rewrites a map while several readers look keys up without locks
+static int test_concurrent(const uint64_t flags){
+
+    int r = EXIT_SUCCESS;
+    concurrent_test_t test;
+    concurrent_value_t value;
+    pthread_t threads[MAX_TEST_THREADS];
+    uint64_t i, g, nthreads = 0;
+
+    test.map = flatmap56_create_ex(0, sizeof(concurrent_value_t), flags | FLATMAP56_CONCURRENT, NULL);
+    test.done = false;
+    test.errors = 0;
+    test.reads = 0;
+    if(!test.map) return EXIT_FAILURE;
+    for(i = 0; i < CONCURRENT_STABLE; i++){
+        value = concurrent_value(concurrent_key(i), 0);
+        if(!flatmap56_write(test.map, concurrent_key(i), &value)) r = EXIT_FAILURE;
+    }
+    for(nthreads = 0; nthreads < MAX_TEST_THREADS / 2; nthreads++){
+        if(pthread_create(&threads[nthreads], NULL, concurrent_reader, &test) != 0) break;
+    }
+    for(g = 1; g <= CONCURRENT_ROUNDS && r == EXIT_SUCCESS; g++){
+        // the first rounds grow the table, which rebuilds it while the readers are scanning it
+        for(i = CONCURRENT_STABLE; i < SAMPLE_SIZE; i++){
+            value = concurrent_value(concurrent_key(i), g);
+            if(!flatmap56_write(test.map, concurrent_key(i), &value)) r = EXIT_FAILURE;
+        }
+        for(i = 0; i < CONCURRENT_STABLE; i++){
+            value = concurrent_value(concurrent_key(i), g);
+            if(!flatmap56_write(test.map, concurrent_key(i), &value)) r = EXIT_FAILURE;
+        }
+        for(i = CONCURRENT_STABLE + g % 2; i < SAMPLE_SIZE; i += 2){
+            if(!flatmap56_remove(test.map, concurrent_key(i), NULL)) r = EXIT_FAILURE;
+        }
+    }
+    // drop the churned keys and rebuild the table at a few sizes while the readers keep scanning it
+    for(i = CONCURRENT_STABLE; i < SAMPLE_SIZE; i++) flatmap56_remove(test.map, concurrent_key(i), NULL);
+    for(g = 0; g < 4 && r == EXIT_SUCCESS; g++){
+        if(!flatmap56_reserve(test.map, SAMPLE_SIZE << g) || !flatmap56_reserve(test.map, 0) || !flatmap56_shrink_to_fit(test.map)) r = EXIT_FAILURE;
+    }
+    __atomic_store_n(&test.done, true, __ATOMIC_RELEASE);
+    for(i = 0; i < nthreads; i++) pthread_join(threads[i], NULL);
+    if(test.errors || nthreads == 0) r = EXIT_FAILURE;
+    // with no reader left every replaced table can be freed
+    value = concurrent_value(concurrent_key(0), CONCURRENT_ROUNDS);
+    if(!flatmap56_write(test.map, concurrent_key(0), &value) || test.map->retired) r = EXIT_FAILURE;
+    for(i = 0; i < CONCURRENT_STABLE && r == EXIT_SUCCESS; i++){
+        if(!flatmap56_read(test.map, concurrent_key(i), &value) || value.tagged != concurrent_value(concurrent_key(i), CONCURRENT_ROUNDS).tagged) r = EXIT_FAILURE;
+    }
+    if(r != EXIT_SUCCESS) fprintf(stderr, "Concurrent map failed (%lu errors in %lu reads)\n", test.errors, test.reads);
+
+    flatmap56_destroy(test.map);
+    return r;
+}
+
+#define COUNTER_HOT  50    // keys that every thread keeps adding to
+#define COUNTER_ADDS 20000 // additions per thread; every other one is to a new key of its own
+#define COUNTER_CAS  2000  // compare-exchange loops per thread on one shared key
+
+typedef struct {
+    flatmap56_t* map;
+    uint64_t     thread;
+    uint64_t     errors;
+}counter_test_t;
+
+// adds to hot keys, inserts new ones (which grows the table under the others) and increments one
+// shared key with compare-exchange loops
+static void* counter_worker(void* arg){
+    counter_test_t* test = (counter_test_t*)arg;
+    uint64_t previous, expected, j;
+    for(j = 0; j < COUNTER_ADDS; j++){
+        uint64_t key = j % 2 ? concurrent_key(COUNTER_HOT + 1 + test->thread * COUNTER_ADDS + j) : concurrent_key(j / 2 % COUNTER_HOT);
+        if(!flatmap56_fetch_add_u64(test->map, key, 1, &previous) || (j % 2 && previous != 0)) test->errors++;
+    }
+    for(j = 0; j < COUNTER_CAS; j++){
+        expected = 0;
+        while(!flatmap56_compare_exchange_u64(test->map, concurrent_key(COUNTER_HOT), &expected, expected + 2));
+    }
+    return NULL;
+}
+
+// several threads update uint64 counters at once while the table grows underneath them
+static int test_counters(const uint64_t flags){
+
+    int r = EXIT_SUCCESS;
+    counter_test_t tests[MAX_TEST_THREADS];
+    pthread_t threads[MAX_TEST_THREADS];
+    uint64_t i, key, value, nthreads = flags & FLATMAP56_CONCURRENT ? MAX_TEST_THREADS / 2 : 1;
+    uint64_t pair[2] = {3, 11};
+    flatmap56_t* map = flatmap56_create_ex(0, sizeof(uint64_t), flags, NULL);
+
+    if(!map) return EXIT_FAILURE;
+    for(i = 0; i < nthreads; i++){
+        tests[i].map = map;
+        tests[i].thread = i;
+        tests[i].errors = 0;
+        if(nthreads == 1) counter_worker(&tests[i]);
+        else if(pthread_create(&threads[i], NULL, counter_worker, &tests[i]) != 0) r = EXIT_FAILURE;
+    }
+    for(i = 0; i < nthreads && nthreads > 1; i++) pthread_join(threads[i], NULL);
+    for(i = 0; i < nthreads; i++) if(tests[i].errors) r = EXIT_FAILURE;
+    if(flatmap56_size(map) != COUNTER_HOT + 1 + nthreads * COUNTER_ADDS / 2) r = EXIT_FAILURE;
+    for(i = 0; i < COUNTER_HOT && r == EXIT_SUCCESS; i++){
+        if(!flatmap56_read(map, concurrent_key(i), &value) || value != nthreads * COUNTER_ADDS / 2 / COUNTER_HOT) r = EXIT_FAILURE;
+    }
+    if(!flatmap56_read(map, concurrent_key(COUNTER_HOT), &value) || value != nthreads * COUNTER_CAS * 2) r = EXIT_FAILURE;
+    // a missing key is only inserted by an exchange that expects 0
+    key = concurrent_key(COUNTER_HOT + 1 + nthreads * COUNTER_ADDS);
+    value = 5;
+    if(flatmap56_compare_exchange_u64(map, key, &value, 7) || value != 0 || flatmap56_lookup(map, key)) r = EXIT_FAILURE;
+    if(!flatmap56_compare_exchange_u64(map, key, &value, 7) || !flatmap56_read(map, key, &value) || value != 7) r = EXIT_FAILURE;
+    if(r != EXIT_SUCCESS) fprintf(stderr, "Atomic counters failed\n");
+    flatmap56_destroy(map);
+
+    // a value too small for a counter is refused
+    map = flatmap56_create_ex(0, sizeof(int), flags, NULL);
+    if(!map || flatmap56_fetch_add_u64(map, 1, 1, NULL) || flatmap56_size(map)) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    // a larger value is a counter followed by bytes the updates leave alone
+    map = flatmap56_create_ex(0, sizeof(pair), flags, NULL);
+    if(!map || !flatmap56_write(map, 1, pair) || !flatmap56_fetch_add_u64(map, 1, 4, NULL)) r = EXIT_FAILURE;
+    else if(!flatmap56_read(map, 1, pair) || pair[0] != 7 || pair[1] != 11) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+    return r;
+}
+
+#define COMBINER_KEYS     3000  // keys shared by every thread
+#define COMBINER_INSERTS  60000 // insertions per thread, each adding its thread number + 1
+#define COMBINER_CAPACITY 512
+
+typedef struct {
+    flatmap56_combiner_t* combiner;
+    uint64_t     thread;
+    uint64_t     errors;
+}combiner_test_t;
+
+static void combiner_add(void* value, const void* incoming, void* ctx){
+    (void)ctx;
+    *(uint64_t*)value += *(const uint64_t*)incoming;
+}
+
+static void* combiner_worker(void* arg){
+    combiner_test_t* test = (combiner_test_t*)arg;
+    flatmap56_buffer_t* buffer = flatmap56_buffer_create(test->combiner, COMBINER_CAPACITY);
+    uint64_t j, value = test->thread + 1;
+    if(!buffer){
+        test->errors++;
+        return NULL;
+    }
+    // every thread starts at a different key
+    for(j = 0; j < COMBINER_INSERTS; j++){
+        if(!flatmap56_buffer_insert(buffer, concurrent_key((j + test->thread * 997) % COMBINER_KEYS), &value)) test->errors++;
+    }
+    flatmap56_buffer_destroy(buffer);
+    return NULL;
+}
+
+// several threads add to shared counters through private buffers merged by a combiner
+static int test_combiner(const uint64_t flags){
+
+    int r = EXIT_SUCCESS;
+    combiner_test_t tests[MAX_TEST_THREADS];
+    pthread_t threads[MAX_TEST_THREADS];
+    uint64_t i, value, expected = 0, nthreads = MAX_TEST_THREADS / 2;
+    flatmap56_t* map = flatmap56_create_ex(0, sizeof(uint64_t), flags, NULL);
+    flatmap56_combiner_t* combiner = map ? flatmap56_combiner_create(map, combiner_add, NULL) : NULL;
+    flatmap56_buffer_t* buffer;
+
+    if(!combiner){
+        flatmap56_destroy(map);
+        return EXIT_FAILURE;
+    }
+    for(i = 0; i < nthreads; i++){
+        tests[i].combiner = combiner;
+        tests[i].thread = i;
+        tests[i].errors = 0;
+        if(pthread_create(&threads[i], NULL, combiner_worker, &tests[i]) != 0) r = EXIT_FAILURE;
+        expected += (i + 1) * (COMBINER_INSERTS / COMBINER_KEYS);
+    }
+    for(i = 0; i < nthreads; i++) pthread_join(threads[i], NULL);
+    for(i = 0; i < nthreads; i++) if(tests[i].errors) r = EXIT_FAILURE;
+    if(!flatmap56_combiner_sync(combiner) || flatmap56_size(map) != COMBINER_KEYS) r = EXIT_FAILURE;
+    for(i = 0; i < COMBINER_KEYS && r == EXIT_SUCCESS; i++){
+        if(!flatmap56_read(map, concurrent_key(i), &value) || value != expected) r = EXIT_FAILURE;
+    }
+    // every buffer flushes once per COMBINER_CAPACITY distinct keys, far less often than it inserts
+    if(flatmap56_combiner_batches(combiner) > nthreads * (COMBINER_INSERTS / COMBINER_CAPACITY + 1) || flatmap56_combiner_combines(combiner) > flatmap56_combiner_batches(combiner) + 1) r = EXIT_FAILURE;
+
+    // without a merge function the value of the latest flush replaces the earlier ones
+    flatmap56_combiner_destroy(combiner);
+    if(!(combiner = flatmap56_combiner_create(map, NULL, NULL))){
+        flatmap56_destroy(map);
+        return EXIT_FAILURE;
+    }
+    buffer = flatmap56_buffer_create(combiner, 4);
+    for(value = 1; value <= 3 && buffer; value++){
+        if(!flatmap56_buffer_insert(buffer, concurrent_key(COMBINER_KEYS), &value) || !flatmap56_buffer_flush(buffer)) r = EXIT_FAILURE;
+    }
+    flatmap56_buffer_destroy(buffer);
+    if(!buffer || !flatmap56_combiner_sync(combiner) || !flatmap56_read(map, concurrent_key(COMBINER_KEYS), &value) || value != 3) r = EXIT_FAILURE;
+    if(r != EXIT_SUCCESS) fprintf(stderr, "Combining inserts failed\n");
+
+    flatmap56_combiner_destroy(combiner);
+    flatmap56_destroy(map);
+    return r;
+}
+
+int main(){
+
+    int r = EXIT_SUCCESS;
+    flatmap56_t* map;
+
+    srand(time(0));
+    //srand(0);
+
+    map = flatmap56_create(0,sizeof(int));
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    fprintf(stdout, "Split layout:\n");
+    map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_SPLIT_LAYOUT,NULL);
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    fprintf(stdout, "Incremental resize:\n");
+    map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_INCREMENTAL_RESIZE,NULL);
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    fprintf(stdout, "In-place growth:\n");
+    map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_INPLACE_GROWTH,NULL);
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    fprintf(stdout, "In-place growth, split layout:\n");
+    map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_INPLACE_GROWTH | FLATMAP56_SPLIT_LAYOUT,NULL);
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    fprintf(stdout, "Occupancy bitmap:\n");
+    map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_OCCUPANCY_BITMAP,NULL);
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    fprintf(stdout, "Occupancy bitmap, in-place growth, split layout:\n");
+    map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_OCCUPANCY_BITMAP | FLATMAP56_INPLACE_GROWTH | FLATMAP56_SPLIT_LAYOUT,NULL);
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    fprintf(stdout, "Grouped layout:\n");
+    map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_GROUPED_LAYOUT,NULL);
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(((uintptr_t)map->buckets & 63) != 0 || !(map->flags & FLATMAP56_SPLIT_LAYOUT)) r = EXIT_FAILURE;
+    // a key that differs from a stored one only above bit 55 must not match it in the block compare;
+    // such a key is never homed in the block of the stored one, so clusters push chains out of theirs
+    for(int i = 0; i < 50; i++){
+        for(uint64_t j = 1; j < 20; j++) *(int*)flatmap56_insert(map, samples[i] + j * CLUSTER_STRIDE) = 0;
+    }
+    for(int i = 0; i < 50; i++){
+        for(uint64_t j = 0; j < 20; j++){
+            for(uint64_t top = 1; top < 256; top++){
+                if(flatmap56_lookup(map, (samples[i] + j * CLUSTER_STRIDE) | top << 56)) r = EXIT_FAILURE;
+            }
+        }
+    }
+    // the headers of empty buckets also hold the key 0
+    *(int*)flatmap56_insert(map,0) = 7;
+    if(flatmap56_lookup(map,0) == NULL || *(int*)flatmap56_lookup(map,0) != 7) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    fprintf(stdout, "Grouped layout, occupancy bitmap, incremental resize:\n");
+    map = flatmap56_create_ex(0,sizeof(int),FLATMAP56_GROUPED_LAYOUT | FLATMAP56_OCCUPANCY_BITMAP | FLATMAP56_INCREMENTAL_RESIZE,NULL);
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+
+    if(flatmap56_create_ex(0,sizeof(int),FLATMAP56_INPLACE_GROWTH | FLATMAP56_INCREMENTAL_RESIZE,NULL) != NULL) r = EXIT_FAILURE;
+    if(flatmap56_create_ex(0,sizeof(int),FLATMAP56_INPLACE_GROWTH | FLATMAP56_GROUPED_LAYOUT,NULL) != NULL) r = EXIT_FAILURE;
+
+    if(test_typed() != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(test_inplace_spill(FLATMAP56_INPLACE_GROWTH) != EXIT_SUCCESS || test_inplace_spill(FLATMAP56_INPLACE_GROWTH | FLATMAP56_SPLIT_LAYOUT | FLATMAP56_OCCUPANCY_BITMAP) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(test_inplace_oom(FLATMAP56_INPLACE_GROWTH) != EXIT_SUCCESS || test_inplace_oom(FLATMAP56_INPLACE_GROWTH | FLATMAP56_SPLIT_LAYOUT | FLATMAP56_OCCUPANCY_BITMAP) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(test_incremental(0) != EXIT_SUCCESS || test_incremental(FLATMAP56_INCREMENTAL_RESIZE) != EXIT_SUCCESS || test_incremental(FLATMAP56_INCREMENTAL_RESIZE | FLATMAP56_SPLIT_LAYOUT) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(test_lookup_batch(0) != EXIT_SUCCESS || test_lookup_batch(FLATMAP56_SPLIT_LAYOUT) != EXIT_SUCCESS || test_lookup_batch(FLATMAP56_GROUPED_LAYOUT) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_try_emplace(FLATMAP56_GROUPED_LAYOUT) != EXIT_SUCCESS || test_build(FLATMAP56_GROUPED_LAYOUT, 4) != EXIT_SUCCESS || test_erase_if(FLATMAP56_GROUPED_LAYOUT) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(test_try_emplace(0) != EXIT_SUCCESS || test_try_emplace(FLATMAP56_INCREMENTAL_RESIZE) != EXIT_SUCCESS || test_try_emplace(FLATMAP56_INPLACE_GROWTH) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_build(FLATMAP56_OCCUPANCY_BITMAP, 4) != EXIT_SUCCESS || test_build(FLATMAP56_OCCUPANCY_BITMAP | FLATMAP56_INCREMENTAL_RESIZE, 1) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(test_build(0, 1) != EXIT_SUCCESS || test_build(0, 4) != EXIT_SUCCESS || test_build(FLATMAP56_SPLIT_LAYOUT, 3) != EXIT_SUCCESS || test_build(FLATMAP56_INCREMENTAL_RESIZE, 4) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_remove_batch(0) != EXIT_SUCCESS || test_remove_batch(FLATMAP56_SPLIT_LAYOUT) != EXIT_SUCCESS || test_remove_batch(FLATMAP56_INCREMENTAL_RESIZE) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_erase_if(0) != EXIT_SUCCESS || test_erase_if(FLATMAP56_SPLIT_LAYOUT) != EXIT_SUCCESS || test_erase_if(FLATMAP56_INCREMENTAL_RESIZE) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_iter(FLATMAP56_OCCUPANCY_BITMAP | FLATMAP56_INCREMENTAL_RESIZE) != EXIT_SUCCESS || test_erase_if(FLATMAP56_OCCUPANCY_BITMAP) != EXIT_SUCCESS || test_remove_batch(FLATMAP56_OCCUPANCY_BITMAP) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(test_iter(0) != EXIT_SUCCESS || test_iter(FLATMAP56_SPLIT_LAYOUT) != EXIT_SUCCESS || test_iter(FLATMAP56_INCREMENTAL_RESIZE) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_scan(0) != EXIT_SUCCESS || test_scan(FLATMAP56_INCREMENTAL_RESIZE) != EXIT_SUCCESS || test_scan(FLATMAP56_INPLACE_GROWTH) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_for_each(0, 1) != EXIT_SUCCESS || test_for_each(FLATMAP56_SPLIT_LAYOUT, 4) != EXIT_SUCCESS || test_for_each(FLATMAP56_INCREMENTAL_RESIZE, MAX_TEST_THREADS) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_reserve(0) != EXIT_SUCCESS || test_reserve(FLATMAP56_INCREMENTAL_RESIZE) != EXIT_SUCCESS || test_reserve(FLATMAP56_INPLACE_GROWTH) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    flatmap56_policy_t policy = flatmap56_default_policy();
+    policy.max_load_factor = 0.5f;
+    policy.growth_factor = 4;
+    if(test_policy(0, &policy) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(test_policy(FLATMAP56_INCREMENTAL_RESIZE, &policy) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(test_policy(FLATMAP56_INPLACE_GROWTH, &policy) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    policy.max_load_factor = 0.875f;
+    policy.growth_factor = 3;
+    policy.never_shrink = true;
+    if(test_policy(FLATMAP56_SPLIT_LAYOUT, &policy) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    fprintf(stdout, "Parallel rehash:\n");
+    policy = flatmap56_default_policy();
+    policy.rehash_threads = 4;
+    map = flatmap56_create_ex(0,sizeof(int),0,&policy);
+    if(test_map(map) != EXIT_SUCCESS || test_churn(map) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    flatmap56_destroy(map);
+    policy.growth_factor = 8;
+    policy.rehash_threads = 3;
+    if(test_policy(FLATMAP56_SPLIT_LAYOUT, &policy) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_concurrent(0) != EXIT_SUCCESS || test_concurrent(FLATMAP56_SPLIT_LAYOUT) != EXIT_SUCCESS || test_concurrent(FLATMAP56_GROUPED_LAYOUT | FLATMAP56_OCCUPANCY_BITMAP) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(flatmap56_create_ex(0,sizeof(int),FLATMAP56_CONCURRENT | FLATMAP56_INCREMENTAL_RESIZE,NULL) != NULL) r = EXIT_FAILURE;
+    if(test_counters(0) != EXIT_SUCCESS || test_counters(FLATMAP56_CONCURRENT) != EXIT_SUCCESS || test_counters(FLATMAP56_CONCURRENT | FLATMAP56_GROUPED_LAYOUT) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    if(test_sharded(0, 0) != EXIT_SUCCESS || test_sharded(4, 0) != EXIT_SUCCESS || test_sharded(3, FLATMAP56_INCREMENTAL_RESIZE) != EXIT_SUCCESS) r = EXIT_FAILURE;
+    if(flatmap56_sharded_create(17, 0, sizeof(int), 0, NULL) != NULL) r = EXIT_FAILURE;
+
+    if(test_combiner(0) != EXIT_SUCCESS || test_combiner(FLATMAP56_CONCURRENT) != EXIT_SUCCESS || test_combiner(FLATMAP56_CONCURRENT | FLATMAP56_GROUPED_LAYOUT) != EXIT_SUCCESS) r = EXIT_FAILURE;
+
+    fprintf(stdout, "%s\n", r == EXIT_SUCCESS ? "All tests passed." : "Tests FAILED.");
     
     return r;
 }
\ No newline at end of file
@@ -5,87 +5,450 @@
 //          https://www.boost.org/LICENSE_1_0.txt)
 
 #include <stdlib.h>
-#include <math.h>
 #include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 #include "geoseq_unordered_flatmap56.h"
+#include "geoseq_unordered_flatmap56_core.h"
+#include "geoseq_probe_tables.h"
 
-#define EMPLACE_EMPTY(BUCKET,KEY,NEXT,DIRECT) \
-    BUCKET->unique_key = KEY; \
-    BUCKET->next_probe = NEXT; \
-    BUCKET->direct_hit = DIRECT
-#define NO_MORE_PROBES      (MAX_PROBES-1)
-#define EMPTY_SLOT          0
+#define ROUND_UP_8(N)       FLATMAP56_ROUND_UP_8(N)
+#define NO_MORE_PROBES      FLATMAP56_NO_MORE_PROBES
+#define EMPTY_SLOT          FLATMAP56_EMPTY_SLOT
 #define MIN(A,B)            ((A) < (B) ? (A) : (B))
 #define MAX(A,B)            ((A) > (B) ? (A) : (B))
-#define CALC_INDEX(MAP,H,P) ((H + (MAP)->probes[P]) & (MAP)->table_mask)
-#define HASH(MAP,KEY)       (((KEY) * 11400714819323198103ul) >> (MAP)->hash_shift)
-#define BUCKET(MAP,INDEX)   ((bucket_t*)(&(MAP)->buckets[(INDEX) * (MAP)->bucket_size]))
-#define NUM_COMMON_RATIOS   58
-const float common_ratios[NUM_COMMON_RATIOS] = {
-    1.007936, 1.017045, 1.02521 , 1.032786, 1.04    , 1.047058, 1.053763, 1.060397,
-    1.067061, 1.073619, 1.080204, 1.086687, 1.093513, 1.1     , 1.106626, 1.112655,
-    1.119395, 1.125382, 1.132877, 1.139668, 1.145878, 1.152606, 1.158852, 1.166347,
-    1.172321, 1.179586, 1.186137, 1.193436, 1.2     , 1.206733, 1.21412 , 1.221013,
-    1.227545, 1.234712, 1.242165, 1.25    , 1.25523 , 1.262626, 1.269855, 1.276308,
-    1.283932, 1.291902, 1.299366, 1.306582, 1.314386, 1.32242 , 1.330434, 1.335375,
-    1.343129, 1.350928, 1.358213, 1.366065, 1.374269, 1.382625, 1.390555, 1.398671,
-    1.404869, 1.412407
+#define CALC_INDEX(MAP,H,P) FLATMAP56_CALC_INDEX(MAP,H,P)
+#define CALC_INDEX_GROUPED(MAP,H,P) FLATMAP56_CALC_INDEX_GROUPED(MAP,H,P)
+#define INDEX(MAP,H,P,GL)   FLATMAP56_INDEX(MAP,H,P,GL)
+#define HASH(MAP,KEY)       FLATMAP56_HASH(MAP,KEY)
+#define BUCKET(MAP,INDEX)   FLATMAP56_BUCKET_AT(MAP,INDEX,(MAP)->bucket_size)
+#define VALUE(MAP,INDEX)    FLATMAP56_VALUE_AT(MAP,INDEX,(MAP)->value_stride)
+#define PREFETCH(ADDR)      __builtin_prefetch((ADDR), 0, 3)
+#define PREFETCH_WRITE(ADDR) __builtin_prefetch((ADDR), 1, 3)
+#define BATCH_WINDOW        16
+#define MIGRATION_STEP      8 // home buckets moved out of the old table per insert or remove
+#define RESERVE_LOAD        0.75f // the highest load factor flatmap56_reserve() sizes a table for
+#define PARTITIONS_PER_THREAD 4   // flatmap56_build() hands out partitions dynamically to balance the threads
+#define MIN_PARTITION_BITS  12    // smaller partitions would defer too many entries near their edges
+#define FOR_EACH_CHUNK      (1ul << 12) // buckets handed to a thread at a time; whole words of the occupancy bitmap
+#define BLOCK_BUCKETS       8  // 8-byte headers per 64-byte cache line in FLATMAP56_GROUPED_LAYOUT
+#define MAX_SHARD_BITS      16
+#define SHARD_MULTIPLIER    0xd6e8feb86659fd93ul // odd and unrelated to the multiplier of HASH
+// the shard of a key is taken from the top bits of a second multiplicative hash
+#define READ_SPINS          64 // failed optimistic reads before a reader yields its time slice
+#define SHARD(MAP,KEY)      (&(MAP)->shards[(((KEY) * SHARD_MULTIPLIER) >> (64 - MAX_SHARD_BITS)) & (MAP)->shard_mask])
+// keys sorted by the whole product of HASH are sorted by home bucket in a table of any size
+#define HOME_ORDER(KEY)     ((KEY) * FLATMAP56_HASH_MULTIPLIER)
+// FLATMAP56_CONCURRENT: every chain is guarded by the seqlock of the stripe of its home bucket. The
+// writer makes the stripe's version odd before it changes the chain and even again afterwards, and
+// waits for the threads counted in the stripe's updaters, which may be in the middle of an atomic
+// update of a value in the chain. versions holds the versions followed by the updater counts. Only
+// the functions of this file open stripes, so the shared core knows nothing about them.
+#define VERSION_STRIPES     4096
+#define STRIPE(MAP,H)       (&(MAP)->versions[(H) & (VERSION_STRIPES - 1)])
+#define UPDATERS(MAP,H)     (&(MAP)->versions[VERSION_STRIPES + ((H) & (VERSION_STRIPES - 1))])
+#define WRITE_BEGIN(MAP,H)  if((MAP)->versions){ \
+                                __atomic_store_n(STRIPE(MAP,H), *STRIPE(MAP,H) + 1, __ATOMIC_SEQ_CST); \
+                                while(__atomic_load_n(UPDATERS(MAP,H), __ATOMIC_SEQ_CST)) sched_yield(); \
+                                __atomic_thread_fence(__ATOMIC_RELEASE); }
+#define WRITE_END(MAP,H)    if((MAP)->versions) __atomic_store_n(STRIPE(MAP,H), *STRIPE(MAP,H) + 1, __ATOMIC_RELEASE)
+
+// A table of a FLATMAP56_CONCURRENT map as its readers see it. The lookup members mirror those of
+// flatmap56_t, so the index macros work on both. A table is published once it is complete and never
+// changes shape afterwards; once replaced it is retired and freed when no reader can still hold it.
+struct flatmap56_table_s {
+    uint64_t        hash_shift;
+    uint64_t        table_mask;
+    uint64_t        block_mask;
+    uint64_t        bucket_size;
+    uint64_t        value_stride;
+    const uint64_t* probes;
+    uint8_t*        buckets;
+    uint8_t*        values;
+    uint8_t*        value_array; // values if it was allocated separately, otherwise NULL
+    uint64_t*       occupancy;
+    uint64_t*       versions;    // those of the map, which the writer hides from itself during a rebuild
+    uint64_t        epoch;       // the global epoch at which the table was retired
+    struct flatmap56_table_s* next;
+};
+
+// The epoch record of a reader thread, alone on its cache line. epoch is the global epoch the thread
+// saw when it started its current read, or 0 while it is not reading. Records are never freed: the
+// record of an exited thread is handed to the next thread that starts reading.
+typedef struct flatmap56_reader_s {
+    uint64_t epoch;
+    uint64_t in_use;
+    struct flatmap56_reader_s* next;
+}__attribute__((aligned(64))) flatmap56_reader_t;
+
+// The reader registry of the concurrent maps created by one copy of this file, which is the library
+// or, with FLATMAP56_HEADER_ONLY, each translation unit. Every concurrent map points to the registry
+// it was created with, so its writer and its readers use the same one whichever copy they call.
+struct flatmap56_registry_s {
+    uint64_t            epoch;
+    flatmap56_reader_t* readers;
+    uint64_t            unregistered; // readers that could not get a record
+    pthread_key_t       key;          // the record of the calling thread
+    pthread_once_t      once;         // creates key before the first concurrent map is created
+    bool                ready;        // true once key exists
+};
+static struct flatmap56_registry_s flatmap56_registry = {1, NULL, 0, 0, PTHREAD_ONCE_INIT, false};
+
+// the update_lock of a FLATMAP56_CONCURRENT map
+struct flatmap56_lock_s {
+    pthread_mutex_t mutex;
+};
+
+// one sub-map of a flatmap56_sharded_t and its lock, alone on its cache line(s)
+struct flatmap56_shard_s {
+    pthread_rwlock_t lock;
+    flatmap56_t*     map;
+}__attribute__((aligned(64)));
+
+// the front end of a map fed by several threads through their flatmap56_buffer_t
+struct flatmap56_combiner_s {
+    pthread_mutex_t lock;     // held by the thread that merges batches into map
+    flatmap56_t*    map;      // changed only by the thread that holds lock
+    void (*merge)(void* value, const void* incoming, void* ctx); // NULL means the incoming value replaces
+    void*           ctx;
+    struct flatmap56_batch_s* pending; // a lock-free stack of the batches waiting to be merged
+    void*           scratch;  // value_size bytes used by the holder of lock to merge into a FLATMAP56_CONCURRENT map
+    uint64_t        combines; // acquisitions of lock
+    uint64_t        batches;  // batches merged into map
+    bool            failed;   // set when an entry could not be inserted into map
+};
+
+// the entries of a flushed flatmap56_buffer_t, sorted by home bucket; keys and values point into
+// the same allocation
+struct flatmap56_batch_s {
+    struct flatmap56_batch_s* next;
+    uint64_t  n;
+    uint64_t* keys;
+    uint8_t*  values;
 };
 
+// a key of a buffer being flushed and its bucket in the buffer
+typedef struct {
+    uint64_t order;
+    uint64_t index;
+}flatmap56_flush_entry_t;
+
+// the state of one in-flight chain walk used by flatmap56_lookup_batch()
+typedef struct {
+    const bucket_t* b;     // the bucket that has been prefetched and will be inspected next
+    uint64_t        index; // the index of the bucket b
+    uint64_t        key;   // the key being searched for
+    uint64_t        h;     // the home index of the key
+    uint64_t        i;     // the position of the key in the caller's array
+    uint64_t        probe; // index into probes[] of the bucket b
+}chain_walk_t;
+
 static inline uint64_t flatmap56_restrict(const uint64_t n, const uint64_t min, const uint64_t max){
     return MIN(MAX(n, min), max);
 }
 
-static inline bool flatmap56_initialize(flatmap56_t* map, uint64_t capacity, const uint64_t value_size) {
+static inline void flatmap56_free_buckets(flatmap56_t* map){
+    if(map->buckets){
+        if(map->flags & FLATMAP56_SPLIT_LAYOUT && map->values != map->buckets) free(map->values);
+        free(map->buckets);
+    }
+    free(map->occupancy);
+    map->buckets = NULL;
+    map->values = NULL;
+    map->occupancy = NULL;
+}
+
+// Frees the bucket arrays of old_map, a copy of map taken before its table was replaced, unless they
+// belong to the table published to the readers of a FLATMAP56_CONCURRENT map.
+static inline void flatmap56_release_buckets(flatmap56_t* map, flatmap56_t* old_map){
+    if(!map->table || map->table->buckets != old_map->buckets) flatmap56_free_buckets(old_map);
+}
+
+static inline void flatmap56_free_table(struct flatmap56_table_s* table){
+    free(table->value_array);
+    free(table->buckets);
+    free(table->occupancy);
+    free(table);
+}
+
+// Hands the record of an exiting thread to the next thread that starts reading.
+static void flatmap56_reader_release(void* record){
+    __atomic_store_n(&((flatmap56_reader_t*)record)->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void flatmap56_registry_init(void){
+    flatmap56_registry.ready = pthread_key_create(&flatmap56_registry.key, flatmap56_reader_release) == 0;
+}
+
+// Returns the epoch record of the calling thread in registry, or NULL if none could be allocated.
+static inline flatmap56_reader_t* flatmap56_reader(struct flatmap56_registry_s* registry){
+    flatmap56_reader_t* r = (flatmap56_reader_t*)pthread_getspecific(registry->key);
+    if(r) return r;
+    for(r = __atomic_load_n(&registry->readers, __ATOMIC_ACQUIRE); r; r = r->next){
+        uint64_t unused = 0;
+        if(__atomic_compare_exchange_n(&r->in_use, &unused, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) break;
+    }
+    if(!r){
+        void* memory;
+        if(posix_memalign(&memory, sizeof(flatmap56_reader_t), sizeof(flatmap56_reader_t))) return NULL;
+        r = (flatmap56_reader_t*)memory;
+        r->epoch = 0;
+        r->in_use = 1;
+        r->next = __atomic_load_n(&registry->readers, __ATOMIC_RELAXED);
+        while(!__atomic_compare_exchange_n(&registry->readers, &r->next, r, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+    pthread_setspecific(registry->key, r);
+    return r;
+}
+
+// Announces that the calling thread is about to load a published table. The announcement is ordered
+// before the load, so a writer that does not see it cannot have retired anything the reader loads.
+static inline flatmap56_reader_t* flatmap56_read_begin(const flatmap56_t* map){
+    flatmap56_reader_t* r = flatmap56_reader(map->registry);
+    if(r) __atomic_store_n(&r->epoch, __atomic_load_n(&map->registry->epoch, __ATOMIC_ACQUIRE), __ATOMIC_SEQ_CST);
+    else __atomic_add_fetch(&map->registry->unregistered, 1, __ATOMIC_SEQ_CST);
+    return r;
+}
+
+static inline void flatmap56_read_end(const flatmap56_t* map, flatmap56_reader_t* r){
+    if(r) __atomic_store_n(&r->epoch, 0, __ATOMIC_RELEASE);
+    else __atomic_sub_fetch(&map->registry->unregistered, 1, __ATOMIC_RELEASE);
+}
+
+// Frees the retired tables of a map that no reader can still be scanning: those retired before the
+// oldest epoch announced by a reader that is in the middle of a read.
+static inline void flatmap56_reclaim(flatmap56_t* map){
+    if(!map->retired || __atomic_load_n(&map->registry->unregistered, __ATOMIC_SEQ_CST)) return;
+    uint64_t oldest = UINT64_MAX;
+    for(flatmap56_reader_t* r = __atomic_load_n(&map->registry->readers, __ATOMIC_ACQUIRE); r; r = r->next){
+        uint64_t epoch = __atomic_load_n(&r->epoch, __ATOMIC_SEQ_CST);
+        if(epoch) oldest = MIN(oldest, epoch);
+    }
+    struct flatmap56_table_s** link = &map->retired;
+    while(*link){
+        struct flatmap56_table_s* table = *link;
+        if(table->epoch < oldest){
+            *link = table->next;
+            flatmap56_free_table(table);
+        }
+        else link = &table->next;
+    }
+}
+
+// Keeps the atomic updates of a FLATMAP56_CONCURRENT map out while its table is rebuilt, so that
+// none of them can land in a table whose values have already been copied.
+static inline void flatmap56_pause_updates(flatmap56_t* map){
+    if(!map->versions) return;
+    __atomic_store_n(&map->resizing, 1, __ATOMIC_SEQ_CST);
+    for(uint64_t s = 0; s < VERSION_STRIPES; s++){
+        while(__atomic_load_n(UPDATERS(map,s), __ATOMIC_SEQ_CST)) sched_yield();
+    }
+}
+
+static inline void flatmap56_resume_updates(flatmap56_t* map){
+    if(map->versions) __atomic_store_n(&map->resizing, 0, __ATOMIC_RELEASE);
+}
+
+// Publishes the current arrays of a FLATMAP56_CONCURRENT map to its readers with a single pointer
+// swap. The table they replace is retired at the current epoch, which then advances: a reader that
+// announces the new epoch is certain to load the new table.
+static inline void flatmap56_publish(flatmap56_t* map, struct flatmap56_table_s* table){
+    table->hash_shift = map->hash_shift;
+    table->table_mask = map->table_mask;
+    table->block_mask = map->block_mask;
+    table->bucket_size = map->bucket_size;
+    table->value_stride = map->value_stride;
+    table->probes = map->probes;
+    table->buckets = map->buckets;
+    table->values = map->values;
+    table->value_array = map->flags & FLATMAP56_SPLIT_LAYOUT && map->values != map->buckets ? map->values : NULL;
+    table->occupancy = map->occupancy;
+    table->versions = map->versions;
+    table->next = NULL;
+    struct flatmap56_table_s* old = map->table;
+    __atomic_store_n(&map->table, table, __ATOMIC_SEQ_CST);
+    if(old){
+        old->epoch = __atomic_load_n(&map->registry->epoch, __ATOMIC_RELAXED);
+        old->next = map->retired;
+        map->retired = old;
+        __atomic_add_fetch(&map->registry->epoch, 1, __ATOMIC_SEQ_CST);
+    }
+    flatmap56_reclaim(map);
+}
+
+// Allocates the bucket array(s) of a map whose value_size and flags have already been set.
+static inline bool flatmap56_initialize(flatmap56_t* map, uint64_t capacity) {
     // determine how many bits we need for the requested capacity
     capacity = flatmap56_restrict(capacity, flatmap56_min_bucket_count(), flatmap56_max_bucket_count(map));
-    unsigned int bits = (unsigned int)(ceil(log2(capacity)));
-    // calculate the probes using a geometric sequence
-    float growth_ratio = common_ratios[bits - 7];
-    double p = 1.0f;
-    map->probes[EMPTY_SLOT] = 0;
-    for(size_t i = 1; i < NO_MORE_PROBES; i++){
-        map->probes[i] = (uint64_t)p;
-        p = ceil(p * growth_ratio);
-    }
-    map->probes[NO_MORE_PROBES] = 0;
+    unsigned int bits = 64 - __builtin_clzl(capacity - 1);
+    // the probes are a geometric sequence shared by every table with the same number of bits
+    map->probes = probe_tables[bits - MIN_TABLE_BITS];
     // initialize the member variables
     map->num_entries = 0;
     map->hash_shift = 64 - bits;
     map->num_buckets = 1ul << bits;
     map->table_mask = map->num_buckets - 1;
-    map->value_size = value_size;
-    map->bucket_size = sizeof(bucket_t) + value_size;
-    if(map->bucket_size & 7) map->bucket_size = ((map->bucket_size >> 3) << 3) + 8; //round up to nearest multiple of 8
-    map->buckets = (uint8_t*)calloc(map->num_buckets, map->bucket_size);
-    if(map->buckets == NULL) return false;
+    map->block_mask = 0;
+    if(map->flags & FLATMAP56_SPLIT_LAYOUT){
+        // the headers are packed 8 to a cache line and the values live in a parallel array
+        map->bucket_size = sizeof(bucket_t);
+        map->value_stride = ROUND_UP_8(map->value_size);
+        if(map->flags & FLATMAP56_GROUPED_LAYOUT){
+            // every block of headers must start a cache line
+            void* headers = NULL;
+            if(posix_memalign(&headers, BLOCK_BUCKETS * sizeof(bucket_t), map->num_buckets * map->bucket_size) != 0) return false;
+            memset(headers, 0, map->num_buckets * map->bucket_size);
+            map->buckets = (uint8_t*)headers;
+            map->block_mask = BLOCK_BUCKETS - 1;
+        }
+        else{
+            map->buckets = (uint8_t*)calloc(map->num_buckets, map->bucket_size);
+        }
+        if(map->buckets == NULL) return false;
+        if(map->value_stride == 0){
+            map->values = map->buckets;
+        }
+        else{
+            map->values = (uint8_t*)calloc(map->num_buckets, map->value_stride);
+            if(map->values == NULL){
+                free(map->buckets);
+                map->buckets = NULL;
+                return false;
+            }
+        }
+    }
+    else{
+        // each value is stored inline immediately after its header
+        map->bucket_size = ROUND_UP_8(sizeof(bucket_t) + map->value_size);
+        map->value_stride = map->bucket_size;
+        map->buckets = (uint8_t*)calloc(map->num_buckets, map->bucket_size);
+        if(map->buckets == NULL) return false;
+        map->values = map->buckets + sizeof(bucket_t);
+    }
+    map->occupancy = NULL;
+    if(map->flags & FLATMAP56_OCCUPANCY_BITMAP){
+        // every table has a multiple of 64 buckets
+        map->occupancy = (uint64_t*)calloc(map->num_buckets / 64, sizeof(uint64_t));
+        if(map->occupancy == NULL){
+            flatmap56_free_buckets(map);
+            return false;
+        }
+    }
     return true;
 }
 
+// Clamps the settings of a policy to values the table can honor.
+static inline void flatmap56_set_policy(flatmap56_t* map, const flatmap56_policy_t* policy){
+    map->policy = *policy;
+    if(!(map->policy.max_load_factor > 0.0f) || map->policy.max_load_factor > 1.0f) map->policy.max_load_factor = 1.0f;
+    map->policy.growth_factor = MIN(MAX(map->policy.growth_factor, 2), 1ul << 32);
+    if(map->policy.growth_factor & (map->policy.growth_factor - 1)){
+        map->policy.growth_factor = 1ul << (64 - __builtin_clzl(map->policy.growth_factor));
+    }
+    if(!(map->policy.min_load_factor > 0.0f)) map->policy.min_load_factor = 0.0f;
+    map->policy.min_load_factor = MIN(map->policy.min_load_factor, map->policy.max_load_factor / 2);
+    map->policy.rehash_threads = MAX(map->policy.rehash_threads, 1);
+}
+
+// Recalculates the number of entries at which the table grows or shrinks. Called after every resize.
+static inline void flatmap56_update_thresholds(flatmap56_t* map){
+    if(map->policy.max_load_factor >= 1.0f) map->grow_at = map->num_buckets + 1; // grow only when emplacing fails
+    else map->grow_at = MAX((uint64_t)(map->policy.max_load_factor * map->num_buckets), 1);
+    if(map->policy.never_shrink || map->num_buckets <= MAX(flatmap56_min_bucket_count(), map->min_buckets)){
+        map->shrink_below = 0;
+    }
+    else{
+        // hysteresis: half of the entries present right now must be removed before the next shrink
+        map->shrink_below = MIN((uint64_t)(map->policy.min_load_factor * map->num_buckets), flatmap56_size(map) / 2);
+    }
+}
+
+inline flatmap56_policy_t flatmap56_default_policy() {
+    flatmap56_policy_t policy;
+    policy.max_load_factor = 1.0f;
+    policy.growth_factor = 2;
+    policy.min_load_factor = 0.375f;
+    policy.never_shrink = false;
+    policy.rehash_threads = 1;
+    return policy;
+}
+
 inline flatmap56_t* flatmap56_create(const uint64_t initial_capacity, const uint64_t value_size) {
+    return flatmap56_create_ex(initial_capacity, value_size, 0, NULL);
+}
+
+inline flatmap56_t* flatmap56_create_ex(const uint64_t initial_capacity, const uint64_t value_size, const uint64_t flags, const flatmap56_policy_t* policy) {
+    if(flags & FLATMAP56_INCREMENTAL_RESIZE && flags & FLATMAP56_INPLACE_GROWTH) return NULL;
+    // realloc() does not keep the blocks of a grouped layout aligned
+    if(flags & FLATMAP56_GROUPED_LAYOUT && flags & FLATMAP56_INPLACE_GROWTH) return NULL;
+    // readers cannot follow entries that move between two tables or arrays that are reallocated
+    if(flags & FLATMAP56_CONCURRENT && flags & (FLATMAP56_INCREMENTAL_RESIZE | FLATMAP56_INPLACE_GROWTH)) return NULL;
     flatmap56_t* map = (flatmap56_t*)calloc(1, sizeof(flatmap56_t));
     if(map){
-        if(!flatmap56_initialize(map, initial_capacity, value_size)){
+        flatmap56_policy_t default_policy = flatmap56_default_policy();
+        map->value_size = value_size;
+        map->flags = flags & FLATMAP56_GROUPED_LAYOUT ? flags | FLATMAP56_SPLIT_LAYOUT : flags;
+        flatmap56_set_policy(map, policy ? policy : &default_policy);
+        if(flags & FLATMAP56_CONCURRENT){
+            pthread_once(&flatmap56_registry.once, flatmap56_registry_init);
+            map->registry = &flatmap56_registry;
+            map->versions = (uint64_t*)calloc(2 * VERSION_STRIPES, sizeof(uint64_t));
+            map->update_lock = (struct flatmap56_lock_s*)malloc(sizeof(struct flatmap56_lock_s));
+            if(!flatmap56_registry.ready || map->versions == NULL || map->update_lock == NULL || pthread_mutex_init(&map->update_lock->mutex, NULL) != 0){
+                free(map->update_lock);
+                free(map->versions);
+                free(map);
+                return NULL;
+            }
+        }
+        if(!flatmap56_initialize(map, initial_capacity)){
             flatmap56_destroy(map);
             return NULL;
         }
+        if(map->versions){
+            struct flatmap56_table_s* table = (struct flatmap56_table_s*)malloc(sizeof(struct flatmap56_table_s));
+            if(table == NULL){
+                flatmap56_destroy(map);
+                return NULL;
+            }
+            flatmap56_publish(map, table);
+        }
+        flatmap56_update_thresholds(map);
     }
     return map;
 }
 
 inline void flatmap56_destroy(flatmap56_t* map) {
     if(map){
-        if(map->buckets) free(map->buckets);
+        if(map->migrating){
+            flatmap56_free_buckets(map->migrating);
+            free(map->migrating);
+        }
+        while(map->retired){
+            struct flatmap56_table_s* table = map->retired;
+            map->retired = table->next;
+            flatmap56_free_table(table);
+        }
+        free(map->table); // its arrays are those of the map
+        flatmap56_free_buckets(map);
+        if(map->update_lock){
+            pthread_mutex_destroy(&map->update_lock->mutex);
+            free(map->update_lock);
+        }
+        free(map->versions);
         free(map);
     }
 }
 
 inline float flatmap56_load_factor(const flatmap56_t* map) {
-    return map->num_buckets == 0 ? 0.0f : (float)map->num_entries / (float)map->num_buckets;
+    return map->num_buckets == 0 ? 0.0f : (float)flatmap56_size(map) / (float)map->num_buckets;
 }
 
 inline uint64_t flatmap56_size(const flatmap56_t* map) {
-    return map->num_entries;
+    return map->num_entries + (map->migrating ? map->migrating->num_entries : 0);
 }
 
 inline uint64_t flatmap56_bucket_count(const flatmap56_t* map) {
@@ -94,7 +457,8 @@ inline uint64_t flatmap56_bucket_count(const flatmap56_t* map) {
 
 inline uint64_t flatmap56_max_bucket_count(const flatmap56_t* map) {
     uint64_t max_keys = 1ul << 56;
-    uint64_t max_buckets = map->bucket_size > 0 ? UINT64_MAX / map->bucket_size : UINT64_MAX;
+    uint64_t stride = MAX(map->bucket_size, map->value_stride);
+    uint64_t max_buckets = stride > 0 ? UINT64_MAX / stride : UINT64_MAX;
     return MIN(max_keys, max_buckets);
 }
 
@@ -102,179 +466,1628 @@ inline uint64_t flatmap56_min_bucket_count() {
     return MAX_PROBES;
 }
 
-inline void* flatmap56_lookup(const flatmap56_t* map, const uint64_t key) {
-    uint64_t  h = HASH(map,key);
-    bucket_t* b = BUCKET(map,h);
-    if(b->unique_key == key) return &b->value[0];
-    if(b->direct_hit){
-        while(b->next_probe != NO_MORE_PROBES){
-            b = BUCKET(map,CALC_INDEX(map,h,b->next_probe));
-            if(b->unique_key == key) return &b->value[0];
-        }
+// Compares key with every header of a cache-line aligned block, ignoring next_probe and direct_hit.
+// Returns two bits per header, both set if it holds key. The header layout is {next_probe:7,
+// direct_hit:1, unique_key:56} from the least significant bit up, as laid out by GCC on x86.
+static inline unsigned int flatmap56_match_block(const bucket_t* block, const uint64_t key) {
+#if defined(__AVX2__)
+    const __m256i k = _mm256_set1_epi64x((long long)(key << 8));
+    const __m256i mask = _mm256_set1_epi64x((long long)~0xfful);
+    __m256i lo = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_load_si256((const __m256i*)&block[0]), mask), k);
+    __m256i hi = _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_load_si256((const __m256i*)&block[4]), mask), k);
+    return (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(lo)) | (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(hi)) << 8;
+#elif defined(__SSE2__)
+    // SSE2 has no 64-bit compare, so each 32-bit half of a header is compared on its own
+    const __m128i k = _mm_set1_epi64x((long long)(key << 8));
+    const __m128i mask = _mm_set1_epi64x((long long)~0xfful);
+    __m128i c0 = _mm_cmpeq_epi32(_mm_and_si128(_mm_load_si128((const __m128i*)&block[0]), mask), k);
+    __m128i c1 = _mm_cmpeq_epi32(_mm_and_si128(_mm_load_si128((const __m128i*)&block[2]), mask), k);
+    __m128i c2 = _mm_cmpeq_epi32(_mm_and_si128(_mm_load_si128((const __m128i*)&block[4]), mask), k);
+    __m128i c3 = _mm_cmpeq_epi32(_mm_and_si128(_mm_load_si128((const __m128i*)&block[6]), mask), k);
+    return (unsigned int)_mm_movemask_epi8(_mm_packs_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3)));
+#else
+    unsigned int matches = 0;
+    for(int q = 0; q < BLOCK_BUCKETS; q++){
+        matches |= (block[q].unique_key == key ? 3u : 0u) << (2 * q);
+    }
+    return matches;
+#endif
+}
+
+// Looks a key up in a FLATMAP56_GROUPED_LAYOUT table. The home bucket is checked first, which is
+// as cheap as it gets and resolves most hits. Otherwise every key of the home block is compared at
+// once, so a key whose chain has not left the home block is found without walking the chain.
+static inline void* flatmap56_find_grouped(const flatmap56_t* map, const uint64_t key) {
+    const uint64_t h = HASH(map,key);
+    const bucket_t* b = BUCKET(map,h);
+    if(b->unique_key == key) return VALUE(map,h);
+    // the block compare only sees the low 56 bits of key, and no header holds a key with more
+    if(!b->direct_hit || key >> 56) return NULL;
+    const uint64_t first = h & ~map->block_mask;
+    unsigned int matches = flatmap56_match_block(BUCKET(map,first), key);
+    matches &= (matches >> 1) & 0x5555;
+    while(matches){
+        // an empty header can only match the key 0
+        const uint64_t i = first + (__builtin_ctz(matches) >> 1);
+        if(BUCKET(map,i)->next_probe != EMPTY_SLOT) return VALUE(map,i);
+        matches &= matches - 1;
+    }
+    // the key is either missing or further along the chain, past the home block
+    while(b->next_probe != NO_MORE_PROBES){
+        const uint64_t i = CALC_INDEX_GROUPED(map,h,b->next_probe);
+        b = BUCKET(map,i);
+        if(b->unique_key == key) return VALUE(map,i);
     }
     return NULL;
 }
 
-static inline void* flatmap56_emplace_direct(flatmap56_t* map, const uint64_t key, const uint64_t h){
-
-    bucket_t* temp;
-    bucket_t* e;
-    bucket_t* empty = NULL;
-    bucket_t* predecessor = NULL;
-    uint8_t   x, y, z; 
-
-    for(x = 0; x < NO_MORE_PROBES; x = z){
-        temp = BUCKET(map, CALC_INDEX(map,h,x));
-        if(temp->unique_key == key) return temp->value;
-        z = temp->next_probe;
-        if(!empty){
-            for(y = x + 1; y < z; y++){
-                e = BUCKET(map, CALC_INDEX(map,h,y));
-                if(e->next_probe == EMPTY_SLOT){
-                    predecessor = temp;
-                    empty = e;
-                    break;
+static inline void* flatmap56_find(const flatmap56_t* map, const uint64_t key) {
+    if(map->block_mask) return flatmap56_find_grouped(map, key);
+    return flatmap56_core_find(map, key, HASH(map,key), map->bucket_size, map->value_stride);
+}
+
+inline void* flatmap56_lookup(const flatmap56_t* map, const uint64_t key) {
+    void* value = flatmap56_find(map, key);
+    if(!value && map->migrating) value = flatmap56_find(map->migrating, key);
+    return value;
+}
+
+inline bool flatmap56_read(const flatmap56_t* map, const uint64_t key, void* value) {
+    if(!(map->flags & FLATMAP56_CONCURRENT)){
+        const void* v = flatmap56_lookup(map, key);
+        if(v && value) memcpy(value, v, map->value_size);
+        return v != NULL;
+    }
+    flatmap56_reader_t* reader = flatmap56_read_begin(map);
+    bool found;
+    for(uint64_t attempt = 1; ; attempt++){
+        if(attempt % READ_SPINS == 0) sched_yield();
+        // the published table is complete and stays allocated until this read ends
+        const struct flatmap56_table_s* table = __atomic_load_n(&map->table, __ATOMIC_SEQ_CST);
+        // walk the chain of the key; a chain torn by the writer can be no longer than MAX_PROBES
+        const uint64_t h = HASH(table,key);
+        const bool grouped = table->block_mask != 0;
+        const uint64_t* stripe = STRIPE(table,h);
+        const uint64_t v = __atomic_load_n(stripe, __ATOMIC_ACQUIRE);
+        if(v & 1) continue;
+        found = false;
+        uint64_t i = h;
+        for(int steps = 0; steps < MAX_PROBES; steps++){
+            bucket_t b;
+            uint64_t header = __atomic_load_n((const uint64_t*)BUCKET(table,i), __ATOMIC_RELAXED);
+            memcpy(&b, &header, sizeof(bucket_t));
+            if(b.unique_key == key){
+                if(value && map->value_size){
+                    // the leading uint64_t may be changed by an atomic update at any time; every
+                    // value is 8-byte aligned and padded to a multiple of 8 bytes
+                    const uint64_t lead = MIN(map->value_size, sizeof(uint64_t));
+                    uint64_t word = __atomic_load_n((const uint64_t*)VALUE(table,i), __ATOMIC_RELAXED);
+                    memcpy(value, &word, lead);
+                    memcpy((uint8_t*)value + lead, (const uint8_t*)VALUE(table,i) + lead, map->value_size - lead);
                 }
+                found = true;
+                break;
             }
+            if((steps == 0 && !b.direct_hit) || b.next_probe == NO_MORE_PROBES || b.next_probe == EMPTY_SLOT) break;
+            i = INDEX(table,h,b.next_probe,grouped);
         }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if(__atomic_load_n(stripe, __ATOMIC_RELAXED) == v) break;
     }
+    flatmap56_read_end(map, reader);
+    return found;
+}
 
-    if(empty){
-        EMPLACE_EMPTY(empty, key, x, 0);
-        predecessor->next_probe = y;
-        map->num_entries++;
-        return empty->value;
+// Calls the instance of flatmap56_core_emplace() that matches the layout of map.
+static inline void* flatmap56_emplace_core(flatmap56_t* map, const uint64_t key) {
+    const uint64_t hs = map->bucket_size, vs = map->value_stride, vz = map->value_size;
+    if(map->block_mask){
+        if(map->occupancy) return flatmap56_core_emplace(map, key, hs, vs, vz, true, true);
+        return flatmap56_core_emplace(map, key, hs, vs, vz, false, true);
     }
+    if(map->occupancy) return flatmap56_core_emplace(map, key, hs, vs, vz, true, false);
+    return flatmap56_core_emplace(map, key, hs, vs, vz, false, false);
+}
 
-    return NULL;
+// Emplaces key into a FLATMAP56_CONCURRENT map with every chain that the emplace may change closed to
+// readers: that of the home bucket h of key and, if h holds an entry of another chain that has to be
+// relocated, that one too. If init is not NULL it is copied into the value before the chains are
+// reopened, so that a reader never sees the key without it.
+static inline void* flatmap56_emplace_guarded(flatmap56_t* map, const uint64_t key, const void* init) {
+    const uint64_t  h = HASH(map,key);
+    const bucket_t* b = BUCKET(map,h);
+    const uint64_t  h2 = b->next_probe != EMPTY_SLOT && !b->direct_hit ? HASH(map,b->unique_key) : h;
+    const bool      other_stripe = (h ^ h2) & (VERSION_STRIPES - 1);
+    void*           value;
+    WRITE_BEGIN(map,h);
+    if(other_stripe){ WRITE_BEGIN(map,h2); }
+    value = flatmap56_emplace_core(map, key);
+    if(value && init) memcpy(value, init, map->value_size);
+    if(other_stripe){ WRITE_END(map,h2); }
+    WRITE_END(map,h);
+    return value;
+}
+
+inline bool flatmap56_write(flatmap56_t* map, const uint64_t key, const void* value) {
+    if(!(map->flags & FLATMAP56_CONCURRENT)){
+        void* v = flatmap56_insert(map, key);
+        if(v) memcpy(v, value, map->value_size);
+        return v != NULL;
+    }
+    // like flatmap56_insert(), but the value is stored under the same seqlock as the key; a
+    // concurrent map neither migrates nor grows in place, so every growth is a plain resize
+    if(FLATMAP56_SHOULD_GROW(map)) flatmap56_resize(map,1);
+    while(!flatmap56_emplace_guarded(map, key, value)){
+        if(!flatmap56_resize(map,1)) return false;
+    }
+    // tables retired by a resize are freed as soon as the readers that might hold them are gone
+    if(map->retired) flatmap56_reclaim(map);
+    return true;
 }
 
-static inline void* flatmap56_emplace_indirect(flatmap56_t* map, const uint64_t key, bucket_t* b){
-
-    bucket_t* e;
-    bucket_t* temp;
-    bucket_t* empty = NULL;
-    bucket_t* predecessor = NULL;
-    uint8_t   x, y, z;
-    
-    uint64_t h2 = HASH(map, b->unique_key);
-
-    for(x = 0; x < NO_MORE_PROBES; x = z){
-        
-        temp = BUCKET(map,CALC_INDEX(map,h2,x));
-        z = temp->next_probe;
-        
-        if(!predecessor){
-            if(b == BUCKET(map,CALC_INDEX(map,h2,z))){
-                predecessor = temp;
-                z = b->next_probe;
-                predecessor->next_probe = z;
+// Finds the value of key in the published table of a FLATMAP56_CONCURRENT map and returns it with
+// the calling thread counted among the updaters of its chain, which keeps the writer from moving or
+// removing the entry until *updaters is decremented. Returns NULL without counting the thread if the
+// key does not exist. The caller holds a reader epoch, so the table cannot be freed meanwhile.
+static inline uint64_t* flatmap56_claim_u64(const flatmap56_t* map, const uint64_t key, uint64_t** updaters){
+    for(uint64_t attempt = 1; ; attempt++){
+        if(attempt % READ_SPINS == 0) sched_yield();
+        const struct flatmap56_table_s* table = __atomic_load_n(&map->table, __ATOMIC_SEQ_CST);
+        const uint64_t h = HASH(table,key);
+        const bool grouped = table->block_mask != 0;
+        uint64_t* count = UPDATERS(table,h);
+        __atomic_add_fetch(count, 1, __ATOMIC_SEQ_CST);
+        // once the writer is seen outside the chain and the table, it waits for this thread
+        if(__atomic_load_n(&map->resizing, __ATOMIC_SEQ_CST) || __atomic_load_n(&map->table, __ATOMIC_SEQ_CST) != table || __atomic_load_n(STRIPE(table,h), __ATOMIC_SEQ_CST) & 1){
+            __atomic_sub_fetch(count, 1, __ATOMIC_RELEASE);
+            continue;
+        }
+        // a home bucket held by another chain may still be changed by the writer
+        uint64_t i = h;
+        for(int steps = 0; steps < MAX_PROBES; steps++){
+            bucket_t b;
+            uint64_t header = __atomic_load_n((const uint64_t*)BUCKET(table,i), __ATOMIC_RELAXED);
+            memcpy(&b, &header, sizeof(bucket_t));
+            if(b.unique_key == key){
+                *updaters = count;
+                return (uint64_t*)VALUE(table,i);
             }
+            if((steps == 0 && !b.direct_hit) || b.next_probe == NO_MORE_PROBES || b.next_probe == EMPTY_SLOT) break;
+            i = INDEX(table,h,b.next_probe,grouped);
         }
-                        
-        if(!empty){
-            for(y = x + 1; y < z; y++){
-                e = BUCKET(map,CALC_INDEX(map,h2,y));
-                if(e->next_probe == EMPTY_SLOT){
-                    empty = e;
-                    EMPLACE_EMPTY(empty,b->unique_key,z,0);
-                    memcpy(empty->value, b->value, map->value_size);
-                    temp->next_probe = y;
-                    break;
-                }
+        __atomic_sub_fetch(count, 1, __ATOMIC_RELEASE);
+        return NULL;
+    }
+}
+
+inline bool flatmap56_fetch_add_u64(flatmap56_t* map, const uint64_t key, const uint64_t delta, uint64_t* previous) {
+    uint64_t *value, *updaters, old = 0;
+    if(map->value_size < sizeof(uint64_t)) return false;
+    if(!(map->flags & FLATMAP56_CONCURRENT)){
+        if(!(value = (uint64_t*)flatmap56_insert(map, key))) return false;
+        old = *value;
+        *value += delta;
+    }
+    else{
+        flatmap56_reader_t* reader = flatmap56_read_begin(map);
+        if((value = flatmap56_claim_u64(map, key, &updaters))){
+            old = __atomic_fetch_add(value, delta, __ATOMIC_SEQ_CST);
+            __atomic_sub_fetch(updaters, 1, __ATOMIC_RELEASE);
+        }
+        flatmap56_read_end(map, reader);
+        if(!value){
+            // the key may have been inserted by another thread since; then it is simply found
+            pthread_mutex_lock(&map->update_lock->mutex);
+            if((value = (uint64_t*)flatmap56_insert(map, key))) old = __atomic_fetch_add(value, delta, __ATOMIC_SEQ_CST);
+            pthread_mutex_unlock(&map->update_lock->mutex);
+            if(!value) return false;
+        }
+    }
+    if(previous) *previous = old;
+    return true;
+}
+
+inline bool flatmap56_compare_exchange_u64(flatmap56_t* map, const uint64_t key, uint64_t* expected, const uint64_t desired) {
+    uint64_t *value, *updaters;
+    bool exchanged = false;
+    if(map->value_size < sizeof(uint64_t)) return false;
+    if(!(map->flags & FLATMAP56_CONCURRENT)){
+        if(!(value = (uint64_t*)flatmap56_lookup(map, key))){
+            if(*expected != 0){
+                *expected = 0;
+                return false;
             }
+            if(!(value = (uint64_t*)flatmap56_insert(map, key))) return false;
+        }
+        if(*value != *expected){
+            *expected = *value;
+            return false;
         }
+        *value = desired;
+        return true;
+    }
+    flatmap56_reader_t* reader = flatmap56_read_begin(map);
+    if((value = flatmap56_claim_u64(map, key, &updaters))){
+        exchanged = __atomic_compare_exchange_n(value, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        __atomic_sub_fetch(updaters, 1, __ATOMIC_RELEASE);
+    }
+    flatmap56_read_end(map, reader);
+    if(!value){
+        // another thread may have inserted the key since, so it is looked up again under the lock; a
+        // key that is still missing holds 0 and is only worth inserting if 0 is expected
+        pthread_mutex_lock(&map->update_lock->mutex);
+        if(!(value = (uint64_t*)flatmap56_lookup(map, key)) && *expected == 0) value = (uint64_t*)flatmap56_insert(map, key);
+        if(value) exchanged = __atomic_compare_exchange_n(value, expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+        else *expected = 0;
+        pthread_mutex_unlock(&map->update_lock->mutex);
+    }
+    return exchanged;
+}
 
-        if(predecessor && empty){
-            EMPLACE_EMPTY(b, key, NO_MORE_PROBES, 1);
-            map->num_entries++;
-            return b->value;
+// Inspects the prefetched bucket of a chain walk. Returns true if the walk has finished, in which
+// case the result has been stored in values[]. Otherwise the walk is advanced to the next bucket in
+// its chain and that bucket is prefetched.
+static inline bool flatmap56_walk_step(const flatmap56_t* map, chain_walk_t* w, void** values, const bool gl){
+    const bucket_t* b = w->b;
+    if(b->unique_key == w->key){
+        values[w->i] = VALUE(map,w->index);
+        return true;
+    }
+    if((w->probe == 0 && !b->direct_hit) || b->next_probe == NO_MORE_PROBES){
+        values[w->i] = NULL;
+        return true;
+    }
+    w->probe = b->next_probe;
+    w->index = INDEX(map,w->h,w->probe,gl);
+    w->b = BUCKET(map,w->index);
+    PREFETCH(w->b);
+    return false;
+}
+
+inline void flatmap56_lookup_batch(const flatmap56_t* map, const uint64_t* keys, const uint64_t n, void** values) {
+    uint64_t     hashes[BATCH_WINDOW];
+    chain_walk_t walks[BATCH_WINDOW]; // a fifo of the walks that did not finish at their home bucket
+    uint64_t     head = 0, count = 0;
+    uint64_t     i, w = MIN(n, BATCH_WINDOW);
+    chain_walk_t walk;
+    const bool   grouped = map->block_mask != 0;
+
+    // get the first window of home buckets in flight
+    for(i = 0; i < w; i++){
+        hashes[i] = HASH(map,keys[i]);
+        PREFETCH(BUCKET(map,hashes[i]));
+    }
+
+    // Resolve the home bucket of key i while prefetching the home bucket of key i + BATCH_WINDOW.
+    // A key that is further down its chain becomes a walk in the fifo, and every iteration advances
+    // the oldest walk by exactly one bucket, so the hops of several chains are in flight at once
+    // instead of each hop stalling the whole loop.
+    for(i = 0; i < n; i++){
+        uint64_t slot = i & (BATCH_WINDOW - 1);
+        walk.key = keys[i];
+        walk.h = hashes[slot];
+        walk.i = i;
+        walk.probe = 0;
+        walk.index = walk.h;
+        walk.b = BUCKET(map,walk.index);
+        if(i + BATCH_WINDOW < n){
+            hashes[slot] = HASH(map,keys[i + BATCH_WINDOW]);
+            PREFETCH(BUCKET(map,hashes[slot]));
+        }
+        if(count){
+            chain_walk_t* oldest = &walks[head];
+            head = (head + 1) & (BATCH_WINDOW - 1);
+            count--;
+            if(!flatmap56_walk_step(map, oldest, values, grouped)){
+                walks[(head + count) & (BATCH_WINDOW - 1)] = *oldest;
+                count++;
+            }
+        }
+        if(!flatmap56_walk_step(map, &walk, values, grouped)){
+            if(count == BATCH_WINDOW){
+                // the fifo is full, so finish the oldest walk to make room
+                while(!flatmap56_walk_step(map, &walks[head], values, grouped));
+                head = (head + 1) & (BATCH_WINDOW - 1);
+                count--;
+            }
+            walks[(head + count) & (BATCH_WINDOW - 1)] = walk;
+            count++;
         }
     }
 
-    return NULL;
+    // drain the remaining walks round-robin
+    while(count){
+        chain_walk_t* oldest = &walks[head];
+        head = (head + 1) & (BATCH_WINDOW - 1);
+        count--;
+        if(!flatmap56_walk_step(map, oldest, values, grouped)){
+            walks[(head + count) & (BATCH_WINDOW - 1)] = *oldest;
+            count++;
+        }
+    }
+
+    // keys that have not been migrated yet are still in the old table
+    if(map->migrating){
+        for(i = 0; i < n; i++){
+            if(!values[i]) values[i] = flatmap56_find(map->migrating, keys[i]);
+        }
+    }
 }
 
 static inline void* flatmap56_emplace(flatmap56_t* map, const uint64_t key) {
-    uint64_t  h = HASH(map,key);
-    bucket_t* b = BUCKET(map,h);
-    if(b->next_probe == EMPTY_SLOT){
-        EMPLACE_EMPTY(b,key,NO_MORE_PROBES,1);
-        map->num_entries++;
-        return b->value;
+    if(map->versions) return flatmap56_emplace_guarded(map, key, NULL);
+    return flatmap56_emplace_core(map, key);
+}
+
+static inline uint64_t flatmap56_next_capacity(const flatmap56_t* map, int action){
+    if(action > 0) return map->num_buckets * map->policy.growth_factor;
+    if(action < 0) return map->num_buckets / 2;
+    return map->num_buckets;
+}
+
+// The argument of one of the threads started by flatmap56_run_threads().
+typedef struct {
+    void*    shared; // the state shared by all of the threads
+    uint64_t t;      // the number of this thread, 0 being the calling thread
+}flatmap56_task_t;
+
+// Runs worker on nthreads threads, the calling thread being thread 0, and waits for all of them.
+// tasks and threads must have room for nthreads elements.
+static inline void flatmap56_run_threads(void* (*worker)(void*), void* shared, flatmap56_task_t* tasks, pthread_t* threads, const uint64_t nthreads){
+    threads[0] = pthread_self();
+    for(uint64_t t = 0; t < nthreads; t++){
+        tasks[t].shared = shared;
+        tasks[t].t = t;
+    }
+    for(uint64_t t = 1; t < nthreads; t++){
+        // a thread that cannot be started does its share on the calling thread instead
+        if(pthread_create(&threads[t], NULL, worker, &tasks[t]) != 0){
+            worker(&tasks[t]);
+            threads[t] = threads[0];
+        }
+    }
+    worker(&tasks[0]);
+    for(uint64_t t = 1; t < nthreads; t++){
+        if(!pthread_equal(threads[t], threads[0])) pthread_join(threads[t], NULL);
+    }
+}
+
+// The shared state of a parallel flatmap56_build() or rehash. The input is radix-partitioned by the
+// top bits of the home bucket, so partition p owns the home buckets [p << part_shift, (p + 1) << part_shift).
+typedef struct {
+    flatmap56_t*    map;
+    const uint64_t* keys;
+    const uint8_t*  values;
+    const flatmap56_t* source;  // the old table of a rehash, whose buckets replace keys and values
+    uint64_t        n;          // the number of input positions: array elements or source buckets
+    uint64_t        nthreads;
+    uint64_t        num_parts;
+    uint64_t        part_shift;
+    uint64_t*       cursors;    // nthreads x num_parts histogram, later the scatter cursors
+    uint64_t*       part_start; // num_parts + 1 offsets into order[]
+    uint64_t*       deferred;   // the number of entries of each partition left for the serial pass
+    uint64_t*       order;      // input positions grouped by partition, in input order within each
+    uint64_t*       entries;    // the number of entries placed by each thread
+    uint64_t        next_part;  // the next partition to be placed; taken atomically
+    int             phase;
+}flatmap56_build_t;
+
+
+static inline uint64_t flatmap56_build_part(const flatmap56_build_t* build, const uint64_t key){
+    return HASH(build->map,key) >> build->part_shift;
+}
+
+// Fetches the key at input position i. Returns false if i is an empty bucket of the source table.
+static inline bool flatmap56_build_key(const flatmap56_build_t* build, const uint64_t i, uint64_t* key){
+    if(build->source){
+        const bucket_t* b = BUCKET(build->source,i);
+        *key = b->unique_key;
+        return b->next_probe != EMPTY_SLOT;
+    }
+    *key = build->keys[i];
+    return true;
+}
+
+static inline const void* flatmap56_build_value(const flatmap56_build_t* build, const uint64_t i){
+    if(build->source) return VALUE(build->source,i);
+    return build->values ? build->values + i * build->map->value_size : NULL;
+}
+
+// Emplaces every entry of a partition restricted to its range of buckets. Entries that do not fit
+// inside the range are compacted to the front of the partition for the serial pass.
+static inline uint64_t flatmap56_build_place(flatmap56_build_t* build, flatmap56_t* local, const uint64_t p){
+    flatmap56_range_t range;
+    uint64_t d = build->part_start[p];
+    range.lo = p << build->part_shift;
+    range.hi = (p + 1) << build->part_shift;
+    for(uint64_t j = build->part_start[p]; j < build->part_start[p + 1]; j++){
+        uint64_t idx = build->order[j], key;
+        const void* source;
+        flatmap56_build_key(build, idx, &key);
+        void* value = flatmap56_core_emplace_range(local, key, local->bucket_size, local->value_stride, local->value_size, local->occupancy != NULL, local->block_mask != 0, &range);
+        if(!value) build->order[d++] = idx;
+        else if((source = flatmap56_build_value(build, idx))) memcpy(value, source, local->value_size);
+    }
+    return d - build->part_start[p];
+}
+
+static void* flatmap56_build_worker(void* arg){
+    flatmap56_build_t* build = (flatmap56_build_t*)((flatmap56_task_t*)arg)->shared;
+    uint64_t t = ((flatmap56_task_t*)arg)->t;
+    uint64_t* cursors = build->cursors + t * build->num_parts;
+    uint64_t begin = build->n * t / build->nthreads;
+    uint64_t end = build->n * (t + 1) / build->nthreads;
+    uint64_t key;
+    if(build->phase == 0){
+        for(uint64_t i = begin; i < end; i++){
+            if(flatmap56_build_key(build, i, &key)) cursors[flatmap56_build_part(build, key)]++;
+        }
+    }
+    else if(build->phase == 1){
+        for(uint64_t i = begin; i < end; i++){
+            if(flatmap56_build_key(build, i, &key)) build->order[cursors[flatmap56_build_part(build, key)]++] = i;
+        }
+    }
+    else{
+        // each thread counts into a private copy of the map
+        flatmap56_t local = *build->map;
+        local.num_entries = 0;
+        for(;;){
+            uint64_t p = __atomic_fetch_add(&build->next_part, 1, __ATOMIC_RELAXED);
+            if(p >= build->num_parts) break;
+            build->deferred[p] = flatmap56_build_place(build, &local, p);
+        }
+        build->entries[t] = local.num_entries;
     }
-    if(b->direct_hit) return flatmap56_emplace_direct(map,key,h);
-    return flatmap56_emplace_indirect(map,key,b);
+    return NULL;
+}
+
+static inline void flatmap56_build_phase(flatmap56_build_t* build, flatmap56_task_t* tasks, pthread_t* threads, const int phase){
+    build->phase = phase;
+    flatmap56_run_threads(flatmap56_build_worker, build, tasks, threads, build->nthreads);
 }
 
-static inline bool flatmap56_resize(flatmap56_t* map, int action){
+// Places the entries of an empty, already sized table on nthreads threads, taking them either from
+// the arrays keys and values or from the buckets of source. Returns false if memory for the
+// partitioning could not be allocated, in which case nothing has been placed, or if the serial pass
+// failed. A rehash never lets the serial pass grow the table, so that it can be abandoned instead.
+static inline bool flatmap56_build_parallel(flatmap56_t* map, const uint64_t* keys, const uint8_t* values, const flatmap56_t* source, const uint64_t n, const uint64_t nthreads){
+    flatmap56_build_t build;
+    uint64_t bits = 64 - map->hash_shift;
+    uint64_t part_bits = 64 - __builtin_clzl(nthreads * PARTITIONS_PER_THREAD - 1);
+    bool result = false;
+
+    memset(&build, 0, sizeof(build));
+    part_bits = MIN(part_bits, bits > MIN_PARTITION_BITS ? bits - MIN_PARTITION_BITS : 0);
+    build.map = map;
+    build.keys = keys;
+    build.values = values;
+    build.source = source;
+    build.n = n;
+    build.nthreads = nthreads;
+    build.num_parts = 1ul << part_bits;
+    build.part_shift = bits - part_bits;
+    build.cursors = (uint64_t*)calloc(nthreads * build.num_parts, sizeof(uint64_t));
+    build.part_start = (uint64_t*)malloc((build.num_parts + 1) * sizeof(uint64_t));
+    build.deferred = (uint64_t*)malloc(build.num_parts * sizeof(uint64_t));
+    build.order = (uint64_t*)malloc((source ? source->num_entries : n) * sizeof(uint64_t));
+    build.entries = (uint64_t*)calloc(nthreads, sizeof(uint64_t));
+    flatmap56_task_t* tasks = (flatmap56_task_t*)malloc(nthreads * sizeof(flatmap56_task_t));
+    pthread_t* threads = (pthread_t*)malloc(nthreads * sizeof(pthread_t));
+
+    if(build.cursors && build.part_start && build.deferred && build.order && build.entries && tasks && threads){
+        flatmap56_build_phase(&build, tasks, threads, 0);
+        // turn the per-thread histograms into the position at which each thread scatters each partition
+        uint64_t offset = 0;
+        for(uint64_t p = 0; p < build.num_parts; p++){
+            build.part_start[p] = offset;
+            for(uint64_t t = 0; t < nthreads; t++){
+                uint64_t count = build.cursors[t * build.num_parts + p];
+                build.cursors[t * build.num_parts + p] = offset;
+                offset += count;
+            }
+        }
+        build.part_start[build.num_parts] = offset;
+        flatmap56_build_phase(&build, tasks, threads, 1);
+        flatmap56_build_phase(&build, tasks, threads, 2);
+        for(uint64_t t = 0; t < nthreads; t++) map->num_entries += build.entries[t];
+        // the chains that did not fit inside their partitions are finished serially without any
+        // range restriction; every occurrence of such a key was deferred, so input order is kept
+        result = true;
+        for(uint64_t p = 0; p < build.num_parts && result; p++){
+            for(uint64_t j = build.part_start[p]; j < build.part_start[p] + build.deferred[p]; j++){
+                uint64_t idx = build.order[j], key;
+                const void* from = flatmap56_build_value(&build, idx);
+                flatmap56_build_key(&build, idx, &key);
+                void* value = source ? flatmap56_emplace(map, key) : flatmap56_insert(map, key);
+                if(!value){
+                    result = false;
+                    break;
+                }
+                if(from) memcpy(value, from, map->value_size);
+            }
+        }
+    }
+
+    free(threads);
+    free(tasks);
+    free(build.entries);
+    free(build.order);
+    free(build.deferred);
+    free(build.part_start);
+    free(build.cursors);
+    return result;
+}
+
+// Rebuilds the table with the given capacity by re-emplacing every entry of the old one.
+static inline bool flatmap56_rehash(flatmap56_t* map, uint64_t capacity){
     flatmap56_t old_map = *map;
-    uint64_t new_capacity;
-    if(action > 0) new_capacity = old_map.num_buckets * 2;
-    else if(action < 0) new_capacity = old_map.num_buckets / 2;
-    else new_capacity = old_map.num_buckets;
-    if(!flatmap56_initialize(map, new_capacity, old_map.value_size)){
+    if(!flatmap56_initialize(map, capacity)){
         *map = old_map;
         return false;
     }
+    if(map->policy.rehash_threads > 1 && map->num_buckets >> MIN_PARTITION_BITS > 1){
+        // the old buckets are scanned in parallel slices and re-emplaced by destination range
+        if(!flatmap56_build_parallel(map, NULL, NULL, &old_map, old_map.num_buckets, map->policy.rehash_threads)){
+            flatmap56_free_buckets(map);
+            *map = old_map;
+            return false;
+        }
+        flatmap56_release_buckets(map, &old_map);
+        flatmap56_update_thresholds(map);
+        return true;
+    }
     for(uint64_t i = 0; i < old_map.num_buckets; i++){
         bucket_t* b = BUCKET(&old_map,i);
         if(b->next_probe != EMPTY_SLOT){
             void* value = flatmap56_emplace(map, b->unique_key);
             if(!value){
-                free(map->buckets);
+                flatmap56_free_buckets(map);
                 *map = old_map;
                 return false;
             }
-            memcpy(value, b->value, map->value_size);
+            memcpy(value, VALUE(&old_map,i), map->value_size);
+        }
+    }
+    flatmap56_release_buckets(map, &old_map);
+    flatmap56_update_thresholds(map);
+    return true;
+}
+
+// The new table of a FLATMAP56_CONCURRENT map is built off to the side while readers keep using the
+// published one, then published in its place. Until then nothing a reader can see changes, so the
+// seqlocks of the chains are left alone.
+static inline bool flatmap56_rebuild(flatmap56_t* map, uint64_t capacity){
+    struct flatmap56_table_s* table = NULL;
+    uint64_t* versions = map->versions;
+    if(versions && !(table = (struct flatmap56_table_s*)malloc(sizeof(struct flatmap56_table_s)))) return false;
+    flatmap56_pause_updates(map);
+    map->versions = NULL;
+    bool r = flatmap56_rehash(map, capacity);
+    map->versions = versions;
+    if(r && table) flatmap56_publish(map, table);
+    else free(table);
+    flatmap56_resume_updates(map);
+    return r;
+}
+
+inline bool flatmap56_resize(flatmap56_t* map, int action){
+    return flatmap56_rebuild(map, flatmap56_next_capacity(map, action));
+}
+
+// Calls the instance of flatmap56_core_unlink() that matches the layout of map.
+static inline bool flatmap56_unlink_core(flatmap56_t* map, const uint64_t key, void* value) {
+    const uint64_t hs = map->bucket_size, vs = map->value_stride, vz = map->value_size;
+    if(map->block_mask){
+        if(map->occupancy) return flatmap56_core_unlink(map, key, value, hs, vs, vz, true, true);
+        return flatmap56_core_unlink(map, key, value, hs, vs, vz, false, true);
+    }
+    if(map->occupancy) return flatmap56_core_unlink(map, key, value, hs, vs, vz, true, false);
+    return flatmap56_core_unlink(map, key, value, hs, vs, vz, false, false);
+}
+
+// Unlinks key from a FLATMAP56_CONCURRENT map with its chain closed to readers.
+static inline bool flatmap56_unlink_guarded(flatmap56_t* map, const uint64_t key, void* value) {
+    const uint64_t h = HASH(map,key);
+    bool r;
+    WRITE_BEGIN(map,h);
+    r = flatmap56_unlink_core(map, key, value);
+    WRITE_END(map,h);
+    return r;
+}
+
+static inline bool flatmap56_unlink(flatmap56_t* map, const uint64_t key, void* value) {
+    if(map->versions) return flatmap56_unlink_guarded(map, key, value);
+    return flatmap56_unlink_core(map, key, value);
+}
+
+// Starts an incremental resize. The current table becomes map->migrating and a new empty table is
+// allocated in its place. The entries are moved across by flatmap56_migrate() a few chains at a time.
+static inline bool flatmap56_start_migration(flatmap56_t* map, int action){
+    flatmap56_t* old_map = (flatmap56_t*)malloc(sizeof(flatmap56_t));
+    if(!old_map) return false;
+    *old_map = *map;
+    if(!flatmap56_initialize(map, flatmap56_next_capacity(map, action))){
+        *map = *old_map;
+        free(old_map);
+        return false;
+    }
+    map->migrating = old_map;
+    map->migrate_index = 0;
+    flatmap56_update_thresholds(map);
+    return true;
+}
+
+// Moves the chains of the next count home buckets of the old table into the new table and frees the
+// old table once it is empty. Each entry is emplaced in the new table before it is unlinked from the
+// old one, so every key is always in exactly one of the two tables. Returns false if the new table
+// is too full to accept an entry, in which case nothing is lost and the migration can be resumed.
+static inline bool flatmap56_migrate(flatmap56_t* map, uint64_t count){
+    flatmap56_t* old_map = map->migrating;
+    for(; count && map->migrate_index < old_map->num_buckets; count--, map->migrate_index++){
+        bucket_t* b = BUCKET(old_map,map->migrate_index);
+        // unlinking the head of a chain pulls its successor into the head bucket
+        while(b->direct_hit){
+            uint64_t key = b->unique_key;
+            void* value = flatmap56_emplace(map, key);
+            if(!value) return false;
+            memcpy(value, VALUE(old_map,map->migrate_index), map->value_size);
+            flatmap56_unlink(old_map, key, NULL);
+        }
+    }
+    if(map->migrate_index == old_map->num_buckets){
+        flatmap56_free_buckets(old_map);
+        free(old_map);
+        map->migrating = NULL;
+    }
+    return true;
+}
+
+// During an in-place growth an entry that still has to be re-placed is pending: it keeps the bucket
+// it was found in, away from its home, as the head of a chain of its own (direct_hit set). Its bucket
+// counts as occupied, so no placement takes it, and keys whose home it is are linked behind it.
+#define IS_PENDING(MAP,INDEX,B) ((B)->direct_hit && HASH(MAP,(B)->unique_key) != (INDEX))
+
+// Takes the pending entry out of bucket i. The first key linked behind it becomes the head.
+static inline void flatmap56_take_pending(flatmap56_t* map, uint64_t i){
+    bucket_t* b = BUCKET(map,i);
+    if(b->next_probe != NO_MORE_PROBES){
+        uint64_t  i2 = CALC_INDEX(map,i,b->next_probe);
+        bucket_t* b2 = BUCKET(map,i2);
+        b->next_probe = b2->next_probe;
+        b->unique_key = b2->unique_key;
+        memcpy(VALUE(map,i), VALUE(map,i2), map->value_size);
+        b = b2;
+        i = i2;
+    }
+    memset(b, 0, sizeof(bucket_t));
+    memset(VALUE(map,i), 0, map->value_size);
+    FLATMAP56_MARK_EMPTY(map,i,map->occupancy != NULL);
+}
+
+// Parks an entry that found no room along its new probe sequence: it becomes pending again in the
+// next empty bucket after *cursor, from which it is re-placed later. No more than half of the
+// buckets are occupied during the growth, so the search always ends.
+static inline void flatmap56_park(flatmap56_t* map, const uint8_t* entry, uint64_t* cursor){
+    bucket_t* b;
+    while(BUCKET(map,*cursor)->next_probe != EMPTY_SLOT) *cursor = (*cursor + 1) & map->table_mask;
+    b = BUCKET(map,*cursor);
+    b->unique_key = ((const bucket_t*)entry)->unique_key;
+    b->next_probe = NO_MORE_PROBES;
+    b->direct_hit = 1;
+    memcpy(VALUE(map,*cursor), entry + sizeof(bucket_t), map->value_size);
+    FLATMAP56_MARK_OCCUPIED(map,*cursor,map->occupancy != NULL);
+}
+
+// Re-places the pending entry of bucket i through temp. Returns 1 if it had to be parked.
+static inline uint64_t flatmap56_replace_bucket(flatmap56_t* map, const uint64_t i, uint8_t* temp, uint64_t* cursor){
+    void* value;
+    memcpy(temp, BUCKET(map,i), sizeof(bucket_t));
+    memcpy(temp + sizeof(bucket_t), VALUE(map,i), map->value_size);
+    flatmap56_take_pending(map, i);
+    value = flatmap56_emplace(map, ((bucket_t*)temp)->unique_key);
+    if(!value){
+        flatmap56_park(map, temp, cursor);
+        return 1;
+    }
+    memcpy(value, temp + sizeof(bucket_t), map->value_size);
+    return 0;
+}
+
+// Moves every pending entry that is left into spill.
+static inline void flatmap56_spill_pending(flatmap56_t* map, flatmap56_t* spill){
+    for(uint64_t i = 0; i < map->num_buckets; i++){
+        bucket_t* b = BUCKET(map,i);
+        if(!IS_PENDING(map,i,b)) continue;
+        void* value = flatmap56_insert(spill, b->unique_key);
+        if(!value) return;
+        memcpy(value, VALUE(map,i), map->value_size);
+        flatmap56_take_pending(map, i);
+    }
+}
+
+// Doubles the size of the bucket array(s) with realloc() and rehashes the entries in place. Because
+// HASH() keeps the top bits of the hash, an entry whose home was i moves to home 2i or 2i+1. Walking
+// the old buckets from the top down therefore writes each entry into the already processed part of
+// the array, and the reads and the writes form two descending streams instead of random accesses.
+// An entry that finds no room is parked in an empty bucket of the table itself and re-placed once
+// the others are in. Entries that still have no room are placed by another doubling. Should that
+// run out of memory, they move to a small table reserved before anything was touched, which is
+// searched and emptied like the old table of an incremental resize. Any table takes 126 entries, so
+// the reserve only needs memory of its own if more than that are left.
+static inline bool flatmap56_grow_in_place(flatmap56_t* map){
+    uint64_t     old_buckets = map->num_buckets;
+    uint64_t     new_buckets = old_buckets * 2;
+    uint64_t     cursor = 0, parked = 0;
+    uint8_t*     temp;
+    uint8_t*     p;
+    flatmap56_t* spill;
+
+    if(new_buckets > flatmap56_max_bucket_count(map)) return false;
+
+    // a failure anywhere here leaves a valid table of the old size behind
+    p = (uint8_t*)realloc(map->buckets, new_buckets * map->bucket_size);
+    if(!p) return false;
+    map->buckets = p;
+    if(map->flags & FLATMAP56_SPLIT_LAYOUT){
+        if(map->value_stride){
+            p = (uint8_t*)realloc(map->values, new_buckets * map->value_stride);
+            if(!p) return false;
+            map->values = p;
+        }
+        else{
+            map->values = map->buckets;
+        }
+    }
+    else{
+        map->values = map->buckets + sizeof(bucket_t);
+    }
+    if(map->occupancy){
+        p = (uint8_t*)realloc(map->occupancy, new_buckets / 64 * sizeof(uint64_t));
+        if(!p) return false;
+        map->occupancy = (uint64_t*)p;
+    }
+    spill = flatmap56_create(0, map->value_size);
+    if(!spill) return false;
+    temp = (uint8_t*)malloc(sizeof(bucket_t) + map->value_size);
+    if(!temp){
+        flatmap56_destroy(spill);
+        return false;
+    }
+
+    // switch to the geometry of the larger table and make every live entry pending; the ones that
+    // already sit in their new home stay where they are
+    map->hash_shift--;
+    map->num_buckets = new_buckets;
+    map->table_mask = new_buckets - 1;
+    map->probes = probe_tables[64 - map->hash_shift - MIN_TABLE_BITS];
+    map->num_entries = 0;
+    for(uint64_t i = 0; i < old_buckets; i++){
+        bucket_t* b = BUCKET(map,i);
+        if(b->next_probe != EMPTY_SLOT){
+            b->next_probe = NO_MORE_PROBES;
+            b->direct_hit = 1;
+            if(HASH(map,b->unique_key) == i) map->num_entries++;
+        }
+    }
+    memset(BUCKET(map,old_buckets), 0, old_buckets * map->bucket_size);
+    if(map->flags & FLATMAP56_SPLIT_LAYOUT) memset(VALUE(map,old_buckets), 0, old_buckets * map->value_stride);
+    if(map->occupancy) memset(map->occupancy + old_buckets / 64, 0, old_buckets / 64 * sizeof(uint64_t));
+
+    for(uint64_t i = old_buckets; i-- > 0;){
+        if(IS_PENDING(map,i,BUCKET(map,i))) parked += flatmap56_replace_bucket(map, i, temp, &cursor);
+    }
+    // give the parked entries another try now that every other entry has been placed
+    if(parked){
+        parked = 0;
+        for(uint64_t i = 0; i < new_buckets; i++){
+            if(IS_PENDING(map,i,BUCKET(map,i))) parked += flatmap56_replace_bucket(map, i, temp, &cursor);
+        }
+    }
+    free(temp);
+    flatmap56_update_thresholds(map);
+    if(parked && !flatmap56_grow_in_place(map)){
+        // the entries that are still pending join those that wait to be migrated, if there are any
+        if(!map->migrating){
+            map->migrating = spill;
+            spill = NULL;
+        }
+        map->migrate_index = 0;
+        flatmap56_spill_pending(map, map->migrating);
+        flatmap56_destroy(spill);
+        return false;
+    }
+    flatmap56_destroy(spill);
+    return true;
+}
+
+static inline bool flatmap56_grow(flatmap56_t* map, int action){
+    if(map->flags & FLATMAP56_INCREMENTAL_RESIZE && !map->migrating) return flatmap56_start_migration(map, action);
+    if(map->flags & FLATMAP56_INPLACE_GROWTH && action > 0){
+        // every in-place growth doubles the table
+        for(uint64_t f = map->policy.growth_factor; f > 1; f >>= 1){
+            if(!flatmap56_grow_in_place(map)) return false;
         }
+        return true;
+    }
+    return flatmap56_resize(map, action);
+}
+
+// Moves everything that is left in the old table, growing the new table if it fills up.
+static inline bool flatmap56_finish_migration(flatmap56_t* map){
+    while(map->migrating){
+        if(!flatmap56_migrate(map, map->migrating->num_buckets) && !flatmap56_grow(map,1)) return false;
     }
-    free(old_map.buckets);
     return true;
 }
 
+static inline void* flatmap56_insert_migrating(flatmap56_t* map, const uint64_t key){
+    void* value;
+    void* old_value;
+    if(!flatmap56_migrate(map, MIGRATION_STEP) && !flatmap56_finish_migration(map)) return NULL;
+    if(!map->migrating) return flatmap56_insert(map, key);
+    old_value = flatmap56_find(map->migrating, key);
+    value = flatmap56_emplace(map, key);
+    if(!value){
+        // the new table is full, so fall back to moving everything now
+        if(!flatmap56_finish_migration(map)) return NULL;
+        return flatmap56_insert(map, key);
+    }
+    if(old_value){
+        // the key has not been migrated yet, so move it across before handing out its value
+        memcpy(value, old_value, map->value_size);
+        flatmap56_unlink(map->migrating, key, NULL);
+    }
+    return value;
+}
+
 inline void* flatmap56_insert(flatmap56_t* map, const uint64_t key) {
-    bucket_t* value = flatmap56_emplace(map,key);
+    void* value;
+    // a growth that fails may still leave entries in map->migrating (see flatmap56_grow_in_place())
+    if(!map->migrating && FLATMAP56_SHOULD_GROW(map)) flatmap56_grow(map,1);
+    if(map->migrating) return flatmap56_insert_migrating(map, key);
+    value = flatmap56_emplace(map,key);
     if(!value){
-        if(flatmap56_resize(map,1)){
-            value = flatmap56_emplace(map,key);
+        if(flatmap56_grow(map,1)){
+            value = flatmap56_insert(map,key);
         }
     }
     return value;
 }
 
+// Every path through flatmap56_insert() either adds exactly one entry or finds the existing one;
+// migrations and resizes move entries around but never change the total count.
+inline void* flatmap56_try_emplace(flatmap56_t* map, const uint64_t key, bool* inserted) {
+    uint64_t size = flatmap56_size(map);
+    void* value = flatmap56_insert(map, key);
+    *inserted = flatmap56_size(map) != size;
+    return value;
+}
+
+inline void* flatmap56_upsert(flatmap56_t* map, const uint64_t key, void (*init)(void* value, uint64_t key, void* ctx), void* ctx) {
+    bool inserted;
+    void* value = flatmap56_try_emplace(map, key, &inserted);
+    if(value && inserted && init) init(value, key, ctx);
+    return value;
+}
+
 inline bool flatmap56_remove(flatmap56_t* map, const uint64_t key, void* value) {
-        
-    uint64_t  h = HASH(map,key);
-    bucket_t* b = BUCKET(map,h);
-    bucket_t* b2 = NULL;
+    if(map->migrating){
+        if(!flatmap56_migrate(map, MIGRATION_STEP)) flatmap56_finish_migration(map);
+        if(map->migrating){
+            // never start another resize while one is still in progress
+            return flatmap56_unlink(map, key, value) || flatmap56_unlink(map->migrating, key, value);
+        }
+    }
+    if(!flatmap56_unlink(map, key, value)) return false;
+    if(FLATMAP56_SHOULD_SHRINK(map)) flatmap56_grow(map,-1);
+    return true;
+}
+
+// Returns a mask with bit j set if bucket first + j is occupied; first must be a multiple of 64. The
+// loop has no branches, so the compiler turns it into a series of compares (vectorized for the
+// split layout).
+static inline uint64_t flatmap56_occupancy(const flatmap56_t* map, const uint64_t first){
+    uint64_t mask = 0;
+    if(map->occupancy) return map->occupancy[first / 64];
+    for(uint64_t j = 0; j < 64; j++) mask |= (uint64_t)(BUCKET(map,first + j)->next_probe != EMPTY_SLOT) << j;
+    return mask;
+}
+
+inline void flatmap56_iter_begin(const flatmap56_t* map, flatmap56_iter_t* iter) {
+    iter->table = map;
+    iter->next_table = map->migrating;
+    iter->index = 0;
+    iter->occupied = flatmap56_occupancy(map, 0);
+}
+
+inline bool flatmap56_iter_next(flatmap56_iter_t* iter, uint64_t* key, void** value) {
+    // every table has a multiple of 64 buckets
+    while(!iter->occupied){
+        iter->index += 64;
+        if(iter->index >= iter->table->num_buckets){
+            if(!iter->next_table) return false;
+            iter->table = iter->next_table;
+            iter->next_table = NULL;
+            iter->index = 0;
+        }
+        iter->occupied = flatmap56_occupancy(iter->table, iter->index);
+    }
+    uint64_t i = iter->index + __builtin_ctzl(iter->occupied);
+    iter->occupied &= iter->occupied - 1;
+    *key = BUCKET(iter->table,i)->unique_key;
+    if(value) *value = VALUE(iter->table,i);
+    return true;
+}
 
-    if(b->direct_hit){
+// Visits every entry whose home bucket is in [first, last).
+static inline void flatmap56_scan_homes(const flatmap56_t* map, const uint64_t first, const uint64_t last, void (*fn)(uint64_t key, void* value, void* ctx), void* ctx){
+    const bool grouped = map->block_mask != 0;
+    for(uint64_t h = first; h < last; h++){
+        uint64_t  i = h;
+        bucket_t* b = BUCKET(map,i);
+        if(!b->direct_hit) continue;
         for(;;){
-            if(b->unique_key == key){
-                if(value) memcpy(value, b->value, map->value_size);
-                if(b2){ // not the head of the list
-                    b2->next_probe = b->next_probe;
-                }
-                else if(b->next_probe != NO_MORE_PROBES){
-                    b2 = BUCKET(map,CALC_INDEX(map,h,b->next_probe));
-                    b->next_probe = b2->next_probe;
-                    b->unique_key = b2->unique_key;
-                    memcpy(b->value, b2->value, map->value_size);
-                    b = b2;
+            fn(b->unique_key, VALUE(map,i), ctx);
+            if(b->next_probe == NO_MORE_PROBES) break;
+            i = INDEX(map,h,b->next_probe,grouped);
+            b = BUCKET(map,i);
+        }
+    }
+}
+
+inline uint64_t flatmap56_scan(const flatmap56_t* map, uint64_t cursor, const uint64_t count, void (*fn)(uint64_t key, void* value, void* ctx), void* ctx) {
+    // During an incremental resize a key may be in either table, so both are scanned over the same
+    // range of hash space, in steps of one home bucket of the smaller table.
+    uint64_t shift = map->migrating ? MAX(map->hash_shift, map->migrating->hash_shift) : map->hash_shift;
+    cursor = cursor >> shift << shift;
+    // a count of 0 still makes progress, so that a caller looping until 0 always terminates
+    for(uint64_t n = 0; n < MAX(count, 1); n++){
+        uint64_t next = cursor + (1ul << shift);
+        flatmap56_scan_homes(map, cursor >> map->hash_shift, (cursor >> map->hash_shift) + (1ul << (shift - map->hash_shift)), fn, ctx);
+        if(map->migrating){
+            flatmap56_scan_homes(map->migrating, cursor >> map->migrating->hash_shift, (cursor >> map->migrating->hash_shift) + (1ul << (shift - map->migrating->hash_shift)), fn, ctx);
+        }
+        // the cursor wraps around to 0 after the last home bucket
+        cursor = next;
+        if(cursor == 0) break;
+    }
+    return cursor;
+}
+
+// The shared state of a flatmap56_parallel_for_each(). The chunks of the new table are numbered
+// before those of the old table of an incremental resize.
+typedef struct {
+    const flatmap56_t* tables[2];
+    uint64_t        chunks[2];
+    void          (*fn)(uint64_t key, void* value, void* ctx, uint64_t thread);
+    void*           ctx;
+    uint64_t        next_chunk; // taken atomically
+}flatmap56_for_each_t;
+
+static void* flatmap56_for_each_worker(void* arg){
+    flatmap56_for_each_t* each = (flatmap56_for_each_t*)((flatmap56_task_t*)arg)->shared;
+    uint64_t t = ((flatmap56_task_t*)arg)->t;
+    for(;;){
+        uint64_t c = __atomic_fetch_add(&each->next_chunk, 1, __ATOMIC_RELAXED);
+        if(c >= each->chunks[0] + each->chunks[1]) break;
+        const flatmap56_t* map = each->tables[c >= each->chunks[0]];
+        uint64_t first = (c >= each->chunks[0] ? c - each->chunks[0] : c) * FOR_EACH_CHUNK;
+        uint64_t last = MIN(first + FOR_EACH_CHUNK, map->num_buckets);
+        for(uint64_t block = first; block < last; block += 64){
+            for(uint64_t occupied = flatmap56_occupancy(map, block); occupied; occupied &= occupied - 1){
+                uint64_t i = block + __builtin_ctzl(occupied);
+                each->fn(BUCKET(map,i)->unique_key, VALUE(map,i), each->ctx, t);
+            }
+        }
+    }
+    return NULL;
+}
+
+inline void flatmap56_parallel_for_each(const flatmap56_t* map, void (*fn)(uint64_t key, void* value, void* ctx, uint64_t thread), void* ctx, uint64_t nthreads) {
+    flatmap56_for_each_t each;
+    flatmap56_task_t task;
+    pthread_t thread;
+    flatmap56_task_t* tasks = NULL;
+    pthread_t* threads = NULL;
+
+    each.tables[0] = map;
+    each.tables[1] = map->migrating;
+    each.chunks[0] = (map->num_buckets + FOR_EACH_CHUNK - 1) / FOR_EACH_CHUNK;
+    each.chunks[1] = map->migrating ? (map->migrating->num_buckets + FOR_EACH_CHUNK - 1) / FOR_EACH_CHUNK : 0;
+    each.fn = fn;
+    each.ctx = ctx;
+    each.next_chunk = 0;
+    nthreads = MIN(MAX(nthreads, 1), each.chunks[0] + each.chunks[1]);
+    if(nthreads > 1){
+        tasks = (flatmap56_task_t*)malloc(nthreads * sizeof(flatmap56_task_t));
+        threads = (pthread_t*)malloc(nthreads * sizeof(pthread_t));
+    }
+    if(tasks && threads) flatmap56_run_threads(flatmap56_for_each_worker, &each, tasks, threads, nthreads);
+    else flatmap56_run_threads(flatmap56_for_each_worker, &each, &task, &thread, 1);
+    free(threads);
+    free(tasks);
+}
+
+// Shrinks a table that many removals have left below its shrink threshold, straight to the size
+// that a series of single removals would have ended up with.
+static inline void flatmap56_shrink_once(flatmap56_t* map){
+    uint64_t capacity = map->num_buckets;
+    if(!FLATMAP56_SHOULD_SHRINK(map) || map->migrating) return;
+    if(map->flags & FLATMAP56_INCREMENTAL_RESIZE){
+        flatmap56_grow(map,-1);
+        return;
+    }
+    while(capacity > MAX(flatmap56_min_bucket_count(), map->min_buckets) && map->num_entries < map->policy.min_load_factor * capacity) capacity /= 2;
+    flatmap56_rebuild(map, capacity);
+}
+
+inline uint64_t flatmap56_remove_batch(flatmap56_t* map, const uint64_t* keys, const uint64_t n, void* values) {
+    uint64_t hashes[BATCH_WINDOW];
+    uint64_t i, removed = 0;
+    uint8_t* out = (uint8_t*)values;
+
+    for(i = 0; i < MIN(n, BATCH_WINDOW); i++){
+        hashes[i] = HASH(map,keys[i]);
+        PREFETCH_WRITE(BUCKET(map,hashes[i]));
+    }
+    // unlink every key without ever resizing, prefetching the home bucket of key i + BATCH_WINDOW
+    for(i = 0; i < n; i++){
+        void* value = out ? out + i * map->value_size : NULL;
+        if(i + BATCH_WINDOW < n){
+            uint64_t slot = i & (BATCH_WINDOW - 1);
+            hashes[slot] = HASH(map,keys[i + BATCH_WINDOW]);
+            PREFETCH_WRITE(BUCKET(map,hashes[slot]));
+        }
+        if(flatmap56_unlink(map, keys[i], value) || (map->migrating && flatmap56_unlink(map->migrating, keys[i], value))) removed++;
+    }
+    flatmap56_shrink_once(map);
+    return removed;
+}
+
+// Frees bucket i, which no chain links to any more.
+static inline void flatmap56_clear_bucket(flatmap56_t* map, const uint64_t i){
+    memset(BUCKET(map,i), 0, sizeof(bucket_t));
+    FLATMAP56_MARK_EMPTY(map,i,map->occupancy != NULL);
+    memset(VALUE(map,i), 0, map->value_size);
+}
+
+// Removes the entries of the chain of home bucket h that satisfy pred in a single walk. Every
+// survivor is linked straight to the previous one, and the first survivor moves into the home bucket
+// if the head itself goes. Returns the number of entries removed.
+static inline uint64_t flatmap56_erase_chain_if(flatmap56_t* map, const uint64_t h, bool (*pred)(uint64_t key, void* value, void* ctx), void* ctx){
+    bucket_t* head = BUCKET(map,h);
+    bucket_t* last = NULL; // the last survivor, NULL until the home bucket holds one
+    bucket_t* b = head;
+    uint64_t  i = h, removed = 0;
+    uint8_t   probe = 0, next;
+    bool      open = false;
+    const bool grouped = map->block_mask != 0;
+
+    for(;;){
+        next = b->next_probe;
+        if(pred(b->unique_key, VALUE(map,i), ctx)){
+            if(!open){ WRITE_BEGIN(map,h); open = true; }
+            if(b != head) flatmap56_clear_bucket(map, i);
+            removed++;
+        }
+        else if(!last){
+            // the first survivor; it becomes the head of the chain
+            if(b != head){
+                if(!open){ WRITE_BEGIN(map,h); open = true; }
+                head->unique_key = b->unique_key;
+                memcpy(VALUE(map,h), VALUE(map,i), map->value_size);
+                flatmap56_clear_bucket(map, i);
+            }
+            last = head;
+        }
+        else{
+            if(last->next_probe != probe){
+                if(!open){ WRITE_BEGIN(map,h); open = true; }
+                last->next_probe = probe;
+            }
+            last = b;
+        }
+        if(next == NO_MORE_PROBES) break;
+        probe = next;
+        i = INDEX(map,h,probe,grouped);
+        b = BUCKET(map,i);
+    }
+    if(open){
+        if(last) last->next_probe = NO_MORE_PROBES;
+        else flatmap56_clear_bucket(map, h);
+        WRITE_END(map,h);
+    }
+    map->num_entries -= removed;
+    return removed;
+}
+
+inline uint64_t flatmap56_erase_if(flatmap56_t* map, bool (*pred)(uint64_t key, void* value, void* ctx), void* ctx) {
+    uint64_t removed = 0;
+    if(map->migrating && !flatmap56_finish_migration(map)) return 0;
+    // every entry is on the chain of its home bucket, so visiting the chains visits each entry once
+    for(uint64_t i = 0; i < map->num_buckets; i++){
+        if(BUCKET(map,i)->direct_hit) removed += flatmap56_erase_chain_if(map, i, pred, ctx);
+    }
+    flatmap56_shrink_once(map);
+    return removed;
+}
+
+// Returns the number of buckets flatmap56_reserve() uses for n entries.
+static inline uint64_t flatmap56_reserve_capacity(const flatmap56_t* map, const uint64_t n){
+    double capacity = (double)n / (double)MIN(map->policy.max_load_factor, RESERVE_LOAD);
+    capacity = MIN(capacity, (double)flatmap56_max_bucket_count(map));
+    capacity = MAX(capacity, (double)flatmap56_min_bucket_count());
+    return 1ul << (64 - __builtin_clzl((uint64_t)capacity - 1));
+}
+
+inline bool flatmap56_reserve(flatmap56_t* map, const uint64_t n) {
+    uint64_t capacity;
+    if(map->migrating && !flatmap56_finish_migration(map)) return false;
+    if(n == 0){
+        map->min_buckets = 0;
+        flatmap56_update_thresholds(map);
+        return true;
+    }
+    capacity = flatmap56_reserve_capacity(map, n);
+    if(map->num_buckets < capacity){
+        if(map->flags & FLATMAP56_INPLACE_GROWTH){
+            while(map->num_buckets < capacity){
+                if(!flatmap56_grow_in_place(map)) return false;
+            }
+        }
+        else if(!flatmap56_rebuild(map, capacity)) return false;
+    }
+    map->min_buckets = capacity;
+    flatmap56_update_thresholds(map);
+    return true;
+}
+
+inline bool flatmap56_shrink_to_fit(flatmap56_t* map) {
+    uint64_t capacity;
+    if(map->migrating && !flatmap56_finish_migration(map)) return false;
+    capacity = MAX(flatmap56_reserve_capacity(map, flatmap56_size(map)), map->min_buckets);
+    if(capacity >= map->num_buckets) return true;
+    return flatmap56_rebuild(map, capacity);
+}
+
+// The table of a FLATMAP56_CONCURRENT map is built off to the side like that of a rebuild.
+inline bool flatmap56_build(flatmap56_t* map, const uint64_t* keys, const void* values, const uint64_t n, const uint64_t nthreads) {
+    struct flatmap56_table_s* table = NULL;
+    uint64_t* versions = map->versions;
+    if(versions && !(table = (struct flatmap56_table_s*)malloc(sizeof(struct flatmap56_table_s)))) return false;
+    flatmap56_pause_updates(map);
+    map->versions = NULL;
+    flatmap56_t old_map = *map;
+    uint64_t capacity = MAX(flatmap56_reserve_capacity(map, n), map->min_buckets);
+    bool result = true;
+    if(!flatmap56_initialize(map, capacity)){
+        *map = old_map;
+        map->versions = versions;
+        free(table);
+        flatmap56_resume_updates(map);
+        return false;
+    }
+    map->migrating = NULL;
+    if(old_map.migrating){
+        flatmap56_free_buckets(old_map.migrating);
+        free(old_map.migrating);
+    }
+    flatmap56_release_buckets(map, &old_map);
+    flatmap56_update_thresholds(map);
+    bool built = false;
+    if(nthreads > 1 && map->num_buckets >> MIN_PARTITION_BITS > 1){
+        built = flatmap56_build_parallel(map, keys, (const uint8_t*)values, NULL, n, nthreads);
+        result = built || map->num_entries == 0;
+    }
+    for(uint64_t i = 0; i < n && !built && result; i++){
+        void* value = flatmap56_insert(map, keys[i]);
+        if(!value) result = false;
+        else if(values) memcpy(value, (const uint8_t*)values + i * map->value_size, map->value_size);
+    }
+    // even a partly built table has replaced the old one
+    map->versions = versions;
+    if(table) flatmap56_publish(map, table);
+    flatmap56_resume_updates(map);
+    return result;
+}
+
+inline flatmap56_sharded_t* flatmap56_sharded_create(const uint64_t shard_bits, const uint64_t initial_capacity, const uint64_t value_size, const uint64_t flags, const flatmap56_policy_t* policy) {
+    if(shard_bits > MAX_SHARD_BITS) return NULL;
+    flatmap56_sharded_t* map = (flatmap56_sharded_t*)calloc(1, sizeof(flatmap56_sharded_t));
+    if(map == NULL) return NULL;
+    void* shards = NULL;
+    if(posix_memalign(&shards, sizeof(flatmap56_shard_t), (1ul << shard_bits) * sizeof(flatmap56_shard_t)) != 0){
+        free(map);
+        return NULL;
+    }
+    map->shards = (flatmap56_shard_t*)shards;
+    map->shard_mask = (1ul << shard_bits) - 1;
+    map->value_size = value_size;
+    // num_shards counts the shards that are ready, so that a failure can be cleaned up by destroy
+    for(map->num_shards = 0; map->num_shards < (1ul << shard_bits); map->num_shards++){
+        flatmap56_shard_t* shard = &map->shards[map->num_shards];
+        shard->map = flatmap56_create_ex(initial_capacity >> shard_bits, value_size, flags, policy);
+        if(shard->map == NULL) break;
+        if(pthread_rwlock_init(&shard->lock, NULL) != 0){
+            flatmap56_destroy(shard->map);
+            break;
+        }
+    }
+    if(map->num_shards < (1ul << shard_bits)){
+        flatmap56_sharded_destroy(map);
+        return NULL;
+    }
+    return map;
+}
+
+inline void flatmap56_sharded_destroy(flatmap56_sharded_t* map) {
+    if(map){
+        for(uint64_t s = 0; s < map->num_shards; s++){
+            pthread_rwlock_destroy(&map->shards[s].lock);
+            flatmap56_destroy(map->shards[s].map);
+        }
+        free(map->shards);
+        free(map);
+    }
+}
+
+inline uint64_t flatmap56_sharded_size(flatmap56_sharded_t* map) {
+    uint64_t size = 0;
+    for(uint64_t s = 0; s < map->num_shards; s++){
+        pthread_rwlock_rdlock(&map->shards[s].lock);
+        size += flatmap56_size(map->shards[s].map);
+        pthread_rwlock_unlock(&map->shards[s].lock);
+    }
+    return size;
+}
+
+inline bool flatmap56_sharded_lookup(flatmap56_sharded_t* map, const uint64_t key, void* value) {
+    flatmap56_shard_t* shard = SHARD(map,key);
+    pthread_rwlock_rdlock(&shard->lock);
+    void* v = flatmap56_lookup(shard->map, key);
+    if(v && value) memcpy(value, v, map->value_size);
+    pthread_rwlock_unlock(&shard->lock);
+    return v != NULL;
+}
+
+// Inserts key into a shard whose write lock is held by the caller.
+static inline bool flatmap56_sharded_store(flatmap56_sharded_t* map, flatmap56_shard_t* shard, const uint64_t key, const void* value) {
+    void* v = flatmap56_insert(shard->map, key);
+    if(v && value) memcpy(v, value, map->value_size);
+    return v != NULL;
+}
+
+inline bool flatmap56_sharded_insert(flatmap56_sharded_t* map, const uint64_t key, const void* value) {
+    flatmap56_shard_t* shard = SHARD(map,key);
+    pthread_rwlock_wrlock(&shard->lock);
+    bool r = flatmap56_sharded_store(map, shard, key, value);
+    pthread_rwlock_unlock(&shard->lock);
+    return r;
+}
+
+inline bool flatmap56_sharded_remove(flatmap56_sharded_t* map, const uint64_t key, void* value) {
+    flatmap56_shard_t* shard = SHARD(map,key);
+    pthread_rwlock_wrlock(&shard->lock);
+    bool r = flatmap56_remove(shard->map, key, value);
+    pthread_rwlock_unlock(&shard->lock);
+    return r;
+}
+
+// Sorts the positions of n keys by shard with a counting sort. Returns an array that holds the
+// sorted positions followed by num_shards + 1 offsets: the positions of the keys of shard s are
+// at [offsets[s], offsets[s + 1]). Returns NULL if memory runs out.
+static inline uint64_t* flatmap56_sharded_group(const flatmap56_sharded_t* map, const uint64_t* keys, const uint64_t n) {
+    uint64_t* order = (uint64_t*)malloc((n + map->num_shards + 1) * sizeof(uint64_t));
+    if(order == NULL) return NULL;
+    uint64_t* offsets = order + n;
+    memset(offsets, 0, (map->num_shards + 1) * sizeof(uint64_t));
+    for(uint64_t i = 0; i < n; i++) offsets[SHARD(map,keys[i]) - map->shards + 1]++;
+    for(uint64_t s = 0; s < map->num_shards; s++) offsets[s + 1] += offsets[s];
+    // offsets[s] is used as the cursor of shard s, which leaves it at the start of shard s + 1
+    for(uint64_t i = 0; i < n; i++) order[offsets[SHARD(map,keys[i]) - map->shards]++] = i;
+    memmove(offsets + 1, offsets, map->num_shards * sizeof(uint64_t));
+    offsets[0] = 0;
+    return order;
+}
+
+inline uint64_t flatmap56_sharded_lookup_batch(flatmap56_sharded_t* map, const uint64_t* keys, const uint64_t n, void* values) {
+    uint8_t* out = (uint8_t*)values;
+    uint64_t found = 0;
+    uint64_t* order = flatmap56_sharded_group(map, keys, n);
+    uint64_t* batch = (uint64_t*)malloc(n * sizeof(uint64_t));
+    void** results = (void**)malloc(n * sizeof(void*));
+    if(order == NULL || batch == NULL || results == NULL){
+        // fall back to locking the shard of every key
+        for(uint64_t i = 0; i < n; i++) found += flatmap56_sharded_lookup(map, keys[i], out ? out + i * map->value_size : NULL);
+    }
+    else{
+        const uint64_t* offsets = order + n;
+        for(uint64_t s = 0; s < map->num_shards; s++){
+            const uint64_t count = offsets[s + 1] - offsets[s];
+            if(count == 0) continue;
+            for(uint64_t j = 0; j < count; j++) batch[j] = keys[order[offsets[s] + j]];
+            pthread_rwlock_rdlock(&map->shards[s].lock);
+            flatmap56_lookup_batch(map->shards[s].map, batch, count, results);
+            for(uint64_t j = 0; j < count; j++){
+                if(results[j] == NULL) continue;
+                found++;
+                if(out) memcpy(out + order[offsets[s] + j] * map->value_size, results[j], map->value_size);
+            }
+            pthread_rwlock_unlock(&map->shards[s].lock);
+        }
+    }
+    free(results);
+    free(batch);
+    free(order);
+    return found;
+}
+
+inline bool flatmap56_sharded_insert_batch(flatmap56_sharded_t* map, const uint64_t* keys, const void* values, const uint64_t n) {
+    const uint8_t* in = (const uint8_t*)values;
+    bool r = true;
+    uint64_t* order = flatmap56_sharded_group(map, keys, n);
+    if(order == NULL){
+        for(uint64_t i = 0; i < n; i++) r &= flatmap56_sharded_insert(map, keys[i], in ? in + i * map->value_size : NULL);
+        return r;
+    }
+    const uint64_t* offsets = order + n;
+    for(uint64_t s = 0; s < map->num_shards; s++){
+        if(offsets[s] == offsets[s + 1]) continue;
+        pthread_rwlock_wrlock(&map->shards[s].lock);
+        for(uint64_t j = offsets[s]; j < offsets[s + 1]; j++){
+            const uint64_t i = order[j];
+            r &= flatmap56_sharded_store(map, &map->shards[s], keys[i], in ? in + i * map->value_size : NULL);
+        }
+        pthread_rwlock_unlock(&map->shards[s].lock);
+    }
+    free(order);
+    return r;
+}
+
+inline uint64_t flatmap56_sharded_remove_batch(flatmap56_sharded_t* map, const uint64_t* keys, const uint64_t n, void* values) {
+    uint8_t* out = (uint8_t*)values;
+    uint64_t removed = 0;
+    uint64_t* order = flatmap56_sharded_group(map, keys, n);
+    if(order == NULL){
+        for(uint64_t i = 0; i < n; i++) removed += flatmap56_sharded_remove(map, keys[i], out ? out + i * map->value_size : NULL);
+        return removed;
+    }
+    const uint64_t* offsets = order + n;
+    for(uint64_t s = 0; s < map->num_shards; s++){
+        if(offsets[s] == offsets[s + 1]) continue;
+        pthread_rwlock_wrlock(&map->shards[s].lock);
+        for(uint64_t j = offsets[s]; j < offsets[s + 1]; j++){
+            const uint64_t i = order[j];
+            removed += flatmap56_remove(map->shards[s].map, keys[i], out ? out + i * map->value_size : NULL);
+        }
+        pthread_rwlock_unlock(&map->shards[s].lock);
+    }
+    free(order);
+    return removed;
+}
+
+// Stores an entry of a batch into the map of a combiner, whose lock the calling thread holds.
+static inline void flatmap56_combiner_store(flatmap56_combiner_t* combiner, const uint64_t key, const void* value){
+    flatmap56_t* map = combiner->map;
+    bool inserted = false;
+    void* present;
+    if(map->flags & FLATMAP56_CONCURRENT){
+        // readers must see a merged value appear at once, so it is merged aside and then written
+        if(combiner->merge && (present = flatmap56_lookup(map, key))){
+            memcpy(combiner->scratch, present, map->value_size);
+            combiner->merge(combiner->scratch, value, combiner->ctx);
+            value = combiner->scratch;
+        }
+        if(!flatmap56_write(map, key, value)) __atomic_store_n(&combiner->failed, true, __ATOMIC_RELAXED);
+        return;
+    }
+    if(!(present = flatmap56_try_emplace(map, key, &inserted))) __atomic_store_n(&combiner->failed, true, __ATOMIC_RELAXED);
+    else if(inserted || !combiner->merge) memcpy(present, value, map->value_size);
+    else combiner->merge(present, value, combiner->ctx);
+}
+
+// Merges every published batch into the map if the combiner lock can be taken, waiting for it if
+// wait is true. Batches are merged in the order they were published, so that the later value of a
+// thread replaces its earlier one, and the entries of a batch in order of their home buckets.
+static inline void flatmap56_combine(flatmap56_combiner_t* combiner, bool wait){
+    const uint64_t vz = combiner->map->value_size;
+    for(;;){
+        if(wait) pthread_mutex_lock(&combiner->lock);
+        else if(pthread_mutex_trylock(&combiner->lock) != 0) return;
+        wait = false;
+        combiner->combines++;
+        struct flatmap56_batch_s* list;
+        while((list = __atomic_exchange_n(&combiner->pending, (struct flatmap56_batch_s*)NULL, __ATOMIC_ACQUIRE))){
+            // the stack holds the newest batch first
+            struct flatmap56_batch_s* batch = NULL;
+            while(list){
+                struct flatmap56_batch_s* next = list->next;
+                list->next = batch;
+                batch = list;
+                list = next;
+            }
+            while(batch){
+                struct flatmap56_batch_s* next = batch->next;
+                for(uint64_t j = 0; j < batch->n; j++){
+                    if(j + BATCH_WINDOW < batch->n) PREFETCH_WRITE(BUCKET(combiner->map,HASH(combiner->map,batch->keys[j + BATCH_WINDOW])));
+                    flatmap56_combiner_store(combiner, batch->keys[j], batch->values + j * vz);
                 }
-                memset(b,0,map->bucket_size);
-                map->num_entries--;
-                // shrink the table if the load factor is less than 37.5%
-                if(map->num_entries < (map->num_buckets >> 2) + (map->num_buckets >> 3)) flatmap56_resize(map,-1);
-                return true;
+                combiner->batches++;
+                free(batch);
+                batch = next;
             }
-            b2 = b; // remember the previous bucket_t
-            if(b->next_probe == NO_MORE_PROBES) break;
-            b = BUCKET(map,CALC_INDEX(map,h,b->next_probe));
         }
+        pthread_mutex_unlock(&combiner->lock);
+        // a thread that published a batch while the lock was held may have failed to take it
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if(!__atomic_load_n(&combiner->pending, __ATOMIC_RELAXED)) return;
     }
+}
 
-    return false;
+// Empties a table without resizing it. Empty buckets must hold zero values.
+static inline void flatmap56_clear_buckets(flatmap56_t* map){
+    memset(map->buckets, 0, map->num_buckets * map->bucket_size);
+    if(map->flags & FLATMAP56_SPLIT_LAYOUT && map->values != map->buckets) memset(map->values, 0, map->num_buckets * map->value_stride);
+    if(map->occupancy) memset(map->occupancy, 0, map->num_buckets / 64 * sizeof(uint64_t));
+    map->num_entries = 0;
+}
+
+static int flatmap56_flush_compare(const void* a, const void* b){
+    const uint64_t x = ((const flatmap56_flush_entry_t*)a)->order, y = ((const flatmap56_flush_entry_t*)b)->order;
+    return (x > y) - (x < y);
+}
+
+inline flatmap56_combiner_t* flatmap56_combiner_create(flatmap56_t* map, void (*merge)(void* value, const void* incoming, void* ctx), void* ctx) {
+    flatmap56_combiner_t* combiner = (flatmap56_combiner_t*)calloc(1, sizeof(flatmap56_combiner_t));
+    if(combiner == NULL) return NULL;
+    combiner->map = map;
+    combiner->merge = merge;
+    combiner->ctx = ctx;
+    combiner->scratch = malloc(MAX(map->value_size, 1));
+    if(combiner->scratch == NULL || pthread_mutex_init(&combiner->lock, NULL) != 0){
+        free(combiner->scratch);
+        free(combiner);
+        return NULL;
+    }
+    return combiner;
+}
+
+inline void flatmap56_combiner_destroy(flatmap56_combiner_t* combiner) {
+    if(combiner){
+        flatmap56_combine(combiner, true);
+        pthread_mutex_destroy(&combiner->lock);
+        free(combiner->scratch);
+        free(combiner);
+    }
+}
+
+inline bool flatmap56_combiner_sync(flatmap56_combiner_t* combiner) {
+    flatmap56_combine(combiner, true);
+    return !__atomic_load_n(&combiner->failed, __ATOMIC_RELAXED);
+}
+
+inline uint64_t flatmap56_combiner_batches(const flatmap56_combiner_t* combiner) {
+    return __atomic_load_n(&combiner->batches, __ATOMIC_RELAXED);
+}
+
+inline uint64_t flatmap56_combiner_combines(const flatmap56_combiner_t* combiner) {
+    return __atomic_load_n(&combiner->combines, __ATOMIC_RELAXED);
+}
+
+inline flatmap56_buffer_t* flatmap56_buffer_create(flatmap56_combiner_t* combiner, const uint64_t capacity) {
+    flatmap56_buffer_t* buffer = (flatmap56_buffer_t*)malloc(sizeof(flatmap56_buffer_t));
+    if(buffer == NULL) return NULL;
+    // the private table is sized for capacity keys once and emptied after every flush
+    flatmap56_policy_t policy = flatmap56_default_policy();
+    policy.never_shrink = true;
+    buffer->combiner = combiner;
+    buffer->capacity = MAX(capacity, 1);
+    buffer->local = flatmap56_create_ex(0, combiner->map->value_size, 0, &policy);
+    if(buffer->local == NULL || !flatmap56_reserve(buffer->local, buffer->capacity)){
+        flatmap56_destroy(buffer->local);
+        free(buffer);
+        return NULL;
+    }
+    return buffer;
+}
+
+inline void flatmap56_buffer_destroy(flatmap56_buffer_t* buffer) {
+    if(buffer){
+        flatmap56_buffer_flush(buffer);
+        flatmap56_destroy(buffer->local);
+        free(buffer);
+    }
+}
+
+inline bool flatmap56_buffer_insert(flatmap56_buffer_t* buffer, const uint64_t key, const void* value) {
+    flatmap56_combiner_t* combiner = buffer->combiner;
+    bool inserted;
+    void* present = flatmap56_try_emplace(buffer->local, key, &inserted);
+    if(present == NULL) return false;
+    if(inserted || !combiner->merge) memcpy(present, value, buffer->local->value_size);
+    else combiner->merge(present, value, combiner->ctx);
+    if(flatmap56_size(buffer->local) >= buffer->capacity) return flatmap56_buffer_flush(buffer);
+    return !__atomic_load_n(&combiner->failed, __ATOMIC_RELAXED);
+}
+
+inline bool flatmap56_buffer_flush(flatmap56_buffer_t* buffer) {
+    flatmap56_combiner_t* combiner = buffer->combiner;
+    flatmap56_t* local = buffer->local;
+    const uint64_t n = flatmap56_size(local), vz = local->value_size;
+    if(n == 0) return !__atomic_load_n(&combiner->failed, __ATOMIC_RELAXED);
+    struct flatmap56_batch_s* batch = (struct flatmap56_batch_s*)malloc(sizeof(struct flatmap56_batch_s) + n * (sizeof(uint64_t) + vz));
+    flatmap56_flush_entry_t* entries = (flatmap56_flush_entry_t*)malloc(n * sizeof(flatmap56_flush_entry_t));
+    uint64_t i, j = 0;
+    for(i = 0; i < local->num_buckets && entries; i++){
+        const bucket_t* b = BUCKET(local,i);
+        if(b->next_probe != EMPTY_SLOT){
+            entries[j].order = HOME_ORDER(b->unique_key);
+            entries[j++].index = i;
+        }
+    }
+    if(batch == NULL || entries == NULL){
+        // merge the buffer straight into the map in bucket order, holding the lock meanwhile
+        free(batch);
+        free(entries);
+        flatmap56_combine(combiner, true);
+        pthread_mutex_lock(&combiner->lock);
+        combiner->combines++;
+        for(i = 0; i < local->num_buckets; i++){
+            const bucket_t* b = BUCKET(local,i);
+            if(b->next_probe != EMPTY_SLOT) flatmap56_combiner_store(combiner, b->unique_key, VALUE(local,i));
+        }
+        pthread_mutex_unlock(&combiner->lock);
+    }
+    else{
+        qsort(entries, n, sizeof(flatmap56_flush_entry_t), flatmap56_flush_compare);
+        batch->n = n;
+        batch->keys = (uint64_t*)(batch + 1);
+        batch->values = (uint8_t*)(batch->keys + n);
+        for(j = 0; j < n; j++){
+            batch->keys[j] = BUCKET(local,entries[j].index)->unique_key;
+            memcpy(batch->values + j * vz, VALUE(local,entries[j].index), vz);
+        }
+        free(entries);
+        batch->next = __atomic_load_n(&combiner->pending, __ATOMIC_RELAXED);
+        while(!__atomic_compare_exchange_n(&combiner->pending, &batch->next, batch, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+    }
+    flatmap56_clear_buckets(local);
+    flatmap56_combine(combiner, false);
+    return !__atomic_load_n(&combiner->failed, __ATOMIC_RELAXED);
 }
 
+#ifdef FLATMAP56_HEADER_ONLY
+// keep the private macros of this file out of the including translation unit
+#undef ROUND_UP_8
+#undef NO_MORE_PROBES
+#undef EMPTY_SLOT
+#undef MIN
+#undef MAX
+#undef CALC_INDEX
+#undef CALC_INDEX_GROUPED
+#undef INDEX
+#undef HASH
+#undef BUCKET
+#undef VALUE
+#undef PREFETCH
+#undef PREFETCH_WRITE
+#undef BATCH_WINDOW
+#undef MIGRATION_STEP
+#undef RESERVE_LOAD
+#undef PARTITIONS_PER_THREAD
+#undef MIN_PARTITION_BITS
+#undef FOR_EACH_CHUNK
+#undef BLOCK_BUCKETS
+#undef READ_SPINS
+#undef MAX_SHARD_BITS
+#undef SHARD_MULTIPLIER
+#undef SHARD
+#undef HOME_ORDER
+#undef VERSION_STRIPES
+#undef STRIPE
+#undef UPDATERS
+#undef WRITE_BEGIN
+#undef WRITE_END
+#undef IS_PENDING
+#endif
@@ -17,8 +17,25 @@
 extern "C" {
 #endif
 
+// Define FLATMAP56_HEADER_ONLY before including this header to compile the whole implementation
+// into the including translation unit as static inline functions, so that the hot path can be
+// inlined into the caller without link-time optimization.
+#ifdef FLATMAP56_HEADER_ONLY
+#define FLATMAP56_API static inline
+#else
+#define FLATMAP56_API
+#endif
+
 #define MAX_PROBES          128
 
+// flags accepted by flatmap56_create_ex()
+#define FLATMAP56_SPLIT_LAYOUT          0x1 // store the headers and the values in separate parallel arrays
+#define FLATMAP56_INCREMENTAL_RESIZE    0x2 // spread each resize over the following inserts and removes
+#define FLATMAP56_INPLACE_GROWTH        0x4 // grow by reallocating the bucket array(s) and rehashing in place
+#define FLATMAP56_OCCUPANCY_BITMAP      0x8 // keep a bit per bucket that tells whether it is occupied
+#define FLATMAP56_GROUPED_LAYOUT        0x10 // split layout with chains that fill the home cache line first; not with FLATMAP56_INPLACE_GROWTH
+#define FLATMAP56_CONCURRENT            0x20 // one writer and any number of lock-free flatmap56_read() callers; not with FLATMAP56_INCREMENTAL_RESIZE or FLATMAP56_INPLACE_GROWTH
+
 typedef struct {
     struct {
         uint64_t next_probe : 7;  // next index into unordered_flatmap56::probes[]
@@ -29,16 +46,74 @@ typedef struct {
 }bucket_t;
 
 typedef struct {
-    uint64_t  hash_shift;
-    uint64_t  num_entries;
-    uint64_t  num_buckets;
-    uint64_t  table_mask;
-    uint64_t  bucket_size;
-    uint64_t  value_size;
-    uint64_t  probes[MAX_PROBES]; // first and last elements are reserved
-    uint8_t*  buckets;
+    float     max_load_factor; // grow before an insertion once the load factor reaches this (1.0 = only when a probe sequence is full)
+    uint64_t  growth_factor;   // multiply the bucket count by this when growing (rounded up to a power of 2, at least 2)
+    float     min_load_factor; // consider shrinking once the load factor drops below this
+    bool      never_shrink;    // never shrink the table
+    uint64_t  rehash_threads;  // threads that rehash the table when it is rebuilt (0 or 1 = the calling thread only)
+}flatmap56_policy_t;
+
+typedef struct flatmap56_s {
+    // the members used by lookups share the first cache line
+    uint64_t        hash_shift;
+    uint64_t        table_mask;
+    uint64_t        block_mask;   // buckets per block - 1; the first probes stay in the home block (0 = no blocks)
+    uint64_t        bucket_size;  // distance between two headers in buckets[]
+    uint64_t        value_stride; // distance between two values in values[]
+    const uint64_t* probes;       // shared read-only table; first and last elements are reserved
+    uint8_t*        buckets;
+    uint8_t*        values;       // points into buckets[] unless FLATMAP56_SPLIT_LAYOUT is set
+    uint64_t        num_entries;
+    uint64_t        num_buckets;
+    uint64_t        value_size;
+    uint64_t        flags;
+    uint64_t*       occupancy;      // a bit per bucket, set if it is occupied; NULL unless FLATMAP56_OCCUPANCY_BITMAP is set
+    uint64_t*       versions;       // the seqlocks of the chains and their atomic updaters, by home bucket; NULL unless FLATMAP56_CONCURRENT is set
+    uint64_t        resizing;       // nonzero while a concurrent map is rebuilt, which keeps atomic updates out
+    struct flatmap56_lock_s* update_lock; // serializes the insertions made by atomic updates of new keys
+    struct flatmap56_table_s* table;   // the table published to readers; NULL unless FLATMAP56_CONCURRENT is set
+    struct flatmap56_table_s* retired; // replaced tables that readers may still be scanning
+    struct flatmap56_registry_s* registry; // the epochs of the readers of a FLATMAP56_CONCURRENT map; NULL otherwise
+    struct flatmap56_s* migrating;  // the old table while an incremental resize is in progress, or the entries an in-place growth could not place
+    uint64_t        migrate_index;  // the next home bucket of the old table to migrate
+    flatmap56_policy_t policy;
+    uint64_t        grow_at;        // grow before an insertion when num_entries reaches this
+    uint64_t        shrink_below;   // shrink after a removal when num_entries drops below this
+    uint64_t        min_buckets;    // the table never shrinks below this many buckets; set by flatmap56_reserve()
 }flatmap56_t;
 
+// the state of an iteration started with flatmap56_iter_begin()
+typedef struct {
+    const flatmap56_t* table;      // the table being scanned
+    const flatmap56_t* next_table; // the old table of an incremental resize, scanned afterwards
+    uint64_t        index;         // the first bucket of the current block of 64 buckets
+    uint64_t        occupied;      // a bit for every occupied bucket of the block not yet visited
+}flatmap56_iter_t;
+
+// one sub-map of a flatmap56_sharded_t and its lock; defined in geoseq_unordered_flatmap56.c, like
+// every other struct that holds a lock, so that this header needs neither the POSIX lock types nor
+// alignment attributes
+typedef struct flatmap56_shard_s flatmap56_shard_t;
+
+// a map split into 2^k independently locked and resized sub-maps; see flatmap56_sharded_create()
+typedef struct {
+    uint64_t           shard_mask;  // 2^k - 1
+    uint64_t           num_shards;
+    uint64_t           value_size;
+    flatmap56_shard_t* shards;
+}flatmap56_sharded_t;
+
+// the front end through which several threads feed one map in batches; defined in
+// geoseq_unordered_flatmap56.c, like its lock; see flatmap56_combiner_create()
+typedef struct flatmap56_combiner_s flatmap56_combiner_t;
+
+// the private buffer of one thread that feeds a flatmap56_combiner_t
+typedef struct {
+    flatmap56_combiner_t* combiner;
+    flatmap56_t*    local;    // aggregates the entries of the thread until it holds capacity keys
+    uint64_t        capacity;
+}flatmap56_buffer_t;
+
 /**
  * @brief Allocates and initializes a flatmap56_t object on the heap. Returns a pointer to the new 
  * object on success or NULL on failure.
@@ -48,14 +123,61 @@ typedef struct {
  * @param value_size The size (in bytes) of the type of value to be stored in the table.
  * @return flatmap56_t*
  */
-flatmap56_t* flatmap56_create(const uint64_t initial_capacity, const uint64_t value_size);
+FLATMAP56_API flatmap56_t* flatmap56_create(const uint64_t initial_capacity, const uint64_t value_size);
+
+/**
+ * @brief Same as flatmap56_create() but also accepts a bitwise OR of FLATMAP56_* flags that select
+ * how the table is laid out in memory. With FLATMAP56_SPLIT_LAYOUT the 8-byte headers are kept in
+ * a dense array and the values in a parallel array indexed by the same bucket index, so chain walks
+ * touch 8 keys per cache line and a value's cache line is only touched on a hit. This is the better
+ * choice when value_size is large. With FLATMAP56_INCREMENTAL_RESIZE a resize allocates the new table
+ * but keeps the old one alive, and every following insert or remove moves a bounded number of old
+ * chains across, so no single call pays for a full rehash. Lookups consult both tables meanwhile.
+ * With FLATMAP56_INPLACE_GROWTH the table grows by reallocating its arrays to twice the size and
+ * re-placing the entries in a streaming pass over the array, so the old and the new table never
+ * exist side by side. FLATMAP56_INCREMENTAL_RESIZE and FLATMAP56_INPLACE_GROWTH are mutually
+ * exclusive; NULL is returned if both are given. With FLATMAP56_OCCUPANCY_BITMAP the table keeps a
+ * bit per bucket that tells whether it is occupied. An insertion then looks for a free bucket in
+ * the bitmap, which is small enough to stay in the cache, instead of loading every bucket along
+ * the probe sequence, and iteration skips empty buckets 64 at a time. It costs 1 bit per bucket.
+ * FLATMAP56_GROUPED_LAYOUT implies FLATMAP56_SPLIT_LAYOUT and keeps the first probes of a chain
+ * inside the cache line of headers that holds its home bucket, so a lookup compares the whole
+ * line at once before it follows the chain any further. It cannot grow in place; NULL is returned
+ * if it is combined with FLATMAP56_INPLACE_GROWTH. With FLATMAP56_CONCURRENT one writer thread
+ * may change the map while any number of other threads read it. Those threads must only use
+ * flatmap56_read(), flatmap56_fetch_add_u64() and flatmap56_compare_exchange_u64(), never
+ * flatmap56_lookup() or the iterators, and the writer must store values with flatmap56_write().
+ * A concurrent map is always resized off to the side, so NULL is returned if it is combined with
+ * FLATMAP56_INCREMENTAL_RESIZE or FLATMAP56_INPLACE_GROWTH.
+ * 
+ * The policy decides when the table grows and shrinks. Out-of-range settings are clamped, and
+ * min_load_factor is limited to half of max_load_factor so that a shrink can never be followed
+ * straight away by a growth. A shrink additionally requires the number of entries to have halved
+ * since the last resize, so a workload that hovers around the shrink threshold does not rehash
+ * over and over.
+ * 
+ * @param initial_capacity The minimum initial capacity of the table.
+ * @param value_size The size (in bytes) of the type of value to be stored in the table.
+ * @param flags A bitwise OR of FLATMAP56_* flags, or 0.
+ * @param policy The growth policy, or NULL for flatmap56_default_policy().
+ * @return flatmap56_t*
+ */
+FLATMAP56_API flatmap56_t* flatmap56_create_ex(const uint64_t initial_capacity, const uint64_t value_size, const uint64_t flags, const flatmap56_policy_t* policy);
+
+/**
+ * @brief Returns the policy used by flatmap56_create(): grow only when a probe sequence is full,
+ * double the bucket count when growing, and shrink below a load factor of 37.5%.
+ * 
+ * @return flatmap56_policy_t
+ */
+FLATMAP56_API flatmap56_policy_t flatmap56_default_policy();
 
 /**
  * @brief Deallocates the instance of a flatmap56_t object pointed to by map.
  * 
  * @param map A pointer to the flatmap56_t object to deallocate.
  */
-void flatmap56_destroy(flatmap56_t* map);
+FLATMAP56_API void flatmap56_destroy(flatmap56_t* map);
 
 /**
  * @brief Calculates and returns the current load factor of the table.
@@ -63,7 +185,7 @@ void flatmap56_destroy(flatmap56_t* map);
  * @param map A pointer to a flatmap56_t.
  * @return float
  */
-float flatmap56_load_factor(const flatmap56_t* map);
+FLATMAP56_API float flatmap56_load_factor(const flatmap56_t* map);
 
 /**
  * @brief Returns the current number of buckets in the hash table.
@@ -71,7 +193,7 @@ float flatmap56_load_factor(const flatmap56_t* map);
  * @param map A pointer to the map.
  * @return uint64_t
  */
-uint64_t flatmap56_bucket_count(const flatmap56_t* map);
+FLATMAP56_API uint64_t flatmap56_bucket_count(const flatmap56_t* map);
 
 /**
  * @brief Returns the maximum number of buckets supported by this implementation.
@@ -79,14 +201,14 @@ uint64_t flatmap56_bucket_count(const flatmap56_t* map);
  * @param map A pointer to the map.
  * @return uint64_t 
  */
-uint64_t flatmap56_max_bucket_count(const flatmap56_t* map);
+FLATMAP56_API uint64_t flatmap56_max_bucket_count(const flatmap56_t* map);
 
 /**
  * @brief Returns the minimum number of buckets supported by this implementation.
  * 
  * @return uint64_t 
  */
-uint64_t flatmap56_min_bucket_count();
+FLATMAP56_API uint64_t flatmap56_min_bucket_count();
 
 /**
  * @brief Returns the current number of elements in the table.
@@ -94,7 +216,7 @@ uint64_t flatmap56_min_bucket_count();
  * @param map A pointer to the flatmap56_t object.
  * @return uint64_t 
  */
-uint64_t flatmap56_size(const flatmap56_t* map);
+FLATMAP56_API uint64_t flatmap56_size(const flatmap56_t* map);
 
 /**
  * @brief Attempts to find the bucket in the hash table that is associated with key. Returns a
@@ -104,7 +226,21 @@ uint64_t flatmap56_size(const flatmap56_t* map);
  * @param key The key to lookup.
  * @return void*
  */
-void* flatmap56_lookup(const flatmap56_t* map, const uint64_t key);
+FLATMAP56_API void* flatmap56_lookup(const flatmap56_t* map, const uint64_t key);
+
+/**
+ * @brief Looks up n keys at once. The home buckets of upcoming keys are prefetched while the
+ * current key is resolved, and keys that live further down their chains are walked as a set of
+ * interleaved state machines, so the cache misses of independent lookups and chain hops overlap.
+ * On return, values[i] holds the same pointer that flatmap56_lookup(map, keys[i]) would have
+ * returned.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param keys An array of n keys to lookup.
+ * @param n The number of keys.
+ * @param values An array of n pointers that receives the results.
+ */
+FLATMAP56_API void flatmap56_lookup_batch(const flatmap56_t* map, const uint64_t* keys, const uint64_t n, void** values);
 
 /**
  * @brief Inserts a new key-value pair into the table. If the table already contains the
@@ -116,7 +252,91 @@ void* flatmap56_lookup(const flatmap56_t* map, const uint64_t key);
  * @param value The value.
  * @return bool
  */
-void* flatmap56_insert(flatmap56_t* map, const uint64_t key);
+FLATMAP56_API void* flatmap56_insert(flatmap56_t* map, const uint64_t key);
+
+/**
+ * @brief Same as flatmap56_insert() but also reports whether the key was new, so that code which
+ * counts or deduplicates keys does not need a flatmap56_lookup() beforehand. The value of a new
+ * key is zero-filled.
+ * 
+ * @param map The flatmap56_t object to insert the key into.
+ * @param key The key.
+ * @param inserted Set to true if the key was added to the table, or false if it already existed.
+ * @return void* A pointer to the value in the table, or NULL on failure.
+ */
+FLATMAP56_API void* flatmap56_try_emplace(flatmap56_t* map, const uint64_t key, bool* inserted);
+
+/**
+ * @brief Same as flatmap56_try_emplace() but calls init(value, key, ctx) to initialize the value
+ * if the key was new. Returns a pointer to the value in the table, or NULL on failure.
+ * 
+ * @param map The flatmap56_t object to insert the key into.
+ * @param key The key.
+ * @param init The function that initializes the value of a new key, or NULL.
+ * @param ctx Passed through to init.
+ * @return void* 
+ */
+FLATMAP56_API void* flatmap56_upsert(flatmap56_t* map, const uint64_t key, void (*init)(void* value, uint64_t key, void* ctx), void* ctx);
+
+/**
+ * @brief Copies the value associated with key into a buffer without taking any lock. Meant for the
+ * readers of a FLATMAP56_CONCURRENT map, which may call it while one writer thread changes the
+ * map. The chain of the key is read optimistically and read again if the writer changed it in the
+ * meantime. A resize builds the new table off to the side, so readers keep using the old one until
+ * the new one is published and never wait for a rebuild; a replaced table is freed once every read
+ * that started before the swap has finished. If value_size is at least 8, the leading uint64_t of
+ * the value is loaded atomically, so an update by flatmap56_fetch_add_u64() or
+ * flatmap56_compare_exchange_u64() is never seen half done.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param key The key to lookup.
+ * @param value A buffer that receives the value, if it is not NULL. Its contents are unspecified if
+ * the key does not exist.
+ * @return bool True if the key exists.
+ */
+FLATMAP56_API bool flatmap56_read(const flatmap56_t* map, const uint64_t key, void* value);
+
+/**
+ * @brief Associates a copy of value with key, inserting the key if it does not exist yet. The
+ * writer of a FLATMAP56_CONCURRENT map must store values this way rather than through the pointer
+ * returned by flatmap56_insert(), so that no reader can see half of a value or a new key before
+ * its value. Returns false if the table could not grow.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param key The key to insert.
+ * @param value The value_size bytes to store.
+ * @return bool 
+ */
+FLATMAP56_API bool flatmap56_write(flatmap56_t* map, const uint64_t key, const void* value);
+
+/**
+ * @brief Atomically adds delta to the value of key, read as a uint64_t, inserting the key with a
+ * value of 0 first if it does not exist. On a FLATMAP56_CONCURRENT map any number of threads may
+ * call it at once, together with flatmap56_compare_exchange_u64() and flatmap56_read(), but
+ * no other function that changes the map. The bucket of an existing key is found without a lock
+ * and updated with a single atomic read-modify-write; only new keys are inserted under a lock.
+ * 
+ * @param map A pointer to the flatmap56_t object, whose value_size must be at least 8.
+ * @param key The key to update.
+ * @param delta The amount to add; the sum wraps around.
+ * @param previous Receives the value before the addition, if it is not NULL.
+ * @return bool False if value_size is less than 8 or the table could not grow.
+ */
+FLATMAP56_API bool flatmap56_fetch_add_u64(flatmap56_t* map, const uint64_t key, const uint64_t delta, uint64_t* previous);
+
+/**
+ * @brief Atomically replaces the value of key, read as a uint64_t, with desired if it equals
+ * *expected. A key that does not exist counts as having a value of 0 and is only inserted if the
+ * exchange succeeds. The same threads may call it as flatmap56_fetch_add_u64().
+ * 
+ * @param map A pointer to the flatmap56_t object, whose value_size must be at least 8.
+ * @param key The key to update.
+ * @param expected The value the key must have; receives its actual value if it is different.
+ * @param desired The value to store.
+ * @return bool True if desired was stored. False if the values differed, value_size is less than
+ * 8 or the table could not grow.
+ */
+FLATMAP56_API bool flatmap56_compare_exchange_u64(flatmap56_t* map, const uint64_t key, uint64_t* expected, const uint64_t desired);
 
 /**
  * @brief Removes the key-value pair associated with key. If the key exists in the table
@@ -128,10 +348,338 @@ void* flatmap56_insert(flatmap56_t* map, const uint64_t key);
  * @param value A buffer into which the corresponding value is copied, if it is not NULL.
  * @return bool 
  */
-bool flatmap56_remove(flatmap56_t* map, const uint64_t key, void* value);
+FLATMAP56_API bool flatmap56_remove(flatmap56_t* map, const uint64_t key, void* value);
+
+/**
+ * @brief Removes n keys at once. The home buckets of upcoming keys are prefetched while the
+ * current key is unlinked, and the table is not resized until every key has been removed, after
+ * which it shrinks at most once, directly to the size that the policy calls for.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param keys An array of n keys to remove.
+ * @param n The number of keys.
+ * @param values An array of n values of value_size bytes each that receives the values of the
+ * removed keys, or NULL. The elements for keys that were not found are left untouched.
+ * @return uint64_t The number of keys that were removed.
+ */
+FLATMAP56_API uint64_t flatmap56_remove_batch(flatmap56_t* map, const uint64_t* keys, const uint64_t n, void* values);
+
+/**
+ * @brief Removes every entry for which pred(key, value, ctx) returns true in a single sequential
+ * sweep over the bucket array. The chains of the removed entries are repaired as the sweep goes,
+ * and the table shrinks at most once, after the sweep. pred is called exactly once for every entry
+ * and may modify the value of an entry it keeps, but it must not modify the map.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param pred Returns true for the entries to remove.
+ * @param ctx Passed through to pred.
+ * @return uint64_t The number of entries that were removed.
+ */
+FLATMAP56_API uint64_t flatmap56_erase_if(flatmap56_t* map, bool (*pred)(uint64_t key, void* value, void* ctx), void* ctx);
+
+/**
+ * @brief Starts an iteration over every key-value pair in the table, in no particular order. The
+ * table is scanned in blocks of 64 buckets: the occupancy of a block is gathered into a bit mask
+ * without branching, and the occupied buckets are then visited by counting trailing zeros, so empty
+ * buckets cost neither a branch nor a misprediction. The map must not be modified while it is being
+ * iterated, apart from writing to the values.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param iter The iterator to initialize.
+ */
+FLATMAP56_API void flatmap56_iter_begin(const flatmap56_t* map, flatmap56_iter_t* iter);
+
+/**
+ * @brief Advances an iterator to the next key-value pair. Returns false once every pair has been
+ * visited.
+ * 
+ * @param iter An iterator initialized by flatmap56_iter_begin().
+ * @param key Receives the key.
+ * @param value Receives a pointer to the value, or NULL if not needed.
+ * @return bool 
+ */
+FLATMAP56_API bool flatmap56_iter_next(flatmap56_iter_t* iter, uint64_t* key, void** value);
+
+/**
+ * @brief Visits the entries of a slice of the table and returns a cursor for the next slice, so
+ * that the map can be walked in small steps between other operations. Start with a cursor of 0 and
+ * pass each returned cursor to the next call until 0 is returned again. The map may be modified and
+ * resized freely between calls: every key that is in the map for the whole scan is visited at least
+ * once, while keys that are inserted or removed during the scan may or may not be visited, and some
+ * keys may be visited more than once after a shrink.
+ * 
+ * This works because the home bucket of a key is the top bits of its hash, so the order of the home
+ * buckets does not change when the table is resized: a table with twice as many buckets splits home
+ * i into homes 2i and 2i + 1. The cursor is the position in hash space up to which the homes have
+ * been visited, and it means the same thing at every table size.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param cursor 0 to start a scan, otherwise the value returned by the previous call.
+ * @param count The number of home buckets to visit; at least one is visited even if count is 0.
+ * @param fn Called with every entry of the slice. It may write to the value but must not modify the map.
+ * @param ctx Passed through to fn.
+ * @return uint64_t The cursor for the next call, or 0 if the scan is complete.
+ */
+FLATMAP56_API uint64_t flatmap56_scan(const flatmap56_t* map, uint64_t cursor, const uint64_t count, void (*fn)(uint64_t key, void* value, void* ctx), void* ctx);
+
+/**
+ * @brief Calls fn for every key-value pair in the table on nthreads threads. The bucket array is
+ * split into ranges of 4096 buckets that the threads take in turn, and each range is scanned the
+ * same way as by flatmap56_iter_next(). fn receives the number of the thread that calls it
+ * (0 to nthreads - 1, 0 being the calling thread), so that aggregates can be accumulated per
+ * thread without any synchronization. fn may write to the value but must not modify the map.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param fn Called with every entry.
+ * @param ctx Passed through to fn.
+ * @param nthreads The number of threads to use, including the calling thread.
+ */
+FLATMAP56_API void flatmap56_parallel_for_each(const flatmap56_t* map, void (*fn)(uint64_t key, void* value, void* ctx, uint64_t thread), void* ctx, uint64_t nthreads);
+
+/**
+ * @brief Grows the table so that n entries fit without any further growth and pins the
+ * resulting bucket count as a floor, so that removals never shrink the table below it. The
+ * table is sized for a load factor of at most 75% (or policy.max_load_factor if lower), which
+ * leaves the probe sequences enough room that an insertion does not run out of probes. Calling
+ * flatmap56_reserve(map, 0) removes the floor. Returns false if the table could not be grown,
+ * in which case the map is unchanged.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param n The number of entries to make room for.
+ * @return bool 
+ */
+FLATMAP56_API bool flatmap56_reserve(flatmap56_t* map, const uint64_t n);
+
+/**
+ * @brief Rebuilds the table with the fewest buckets that hold its current entries the way
+ * flatmap56_reserve() would size it, but never fewer than the floor set by flatmap56_reserve().
+ * Does nothing if the table is already that small. Returns false if the table could not be
+ * rebuilt, in which case the map is unchanged.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @return bool 
+ */
+FLATMAP56_API bool flatmap56_shrink_to_fit(flatmap56_t* map);
+
+/**
+ * @brief Replaces the contents of the table with n key-value pairs taken from two arrays. The table
+ * is sized once, as flatmap56_reserve(map, n) would, and the input is radix-partitioned by the top
+ * bits of the home bucket so that each of nthreads threads builds the chains of a disjoint range of
+ * home buckets. The few entries whose chains would cross into a neighbouring range are placed
+ * afterwards by a serial pass. If a key occurs more than once, the last occurrence wins. Returns
+ * false on failure: the map is unchanged if the new table could not be allocated, and it may hold
+ * a subset of the input otherwise.
+ * 
+ * @param map A pointer to the flatmap56_t object.
+ * @param keys An array of n keys.
+ * @param values An array of n values of value_size bytes each, or NULL to zero-fill the values.
+ * @param n The number of key-value pairs.
+ * @param nthreads The number of threads to use, including the calling thread.
+ * @return bool 
+ */
+FLATMAP56_API bool flatmap56_build(flatmap56_t* map, const uint64_t* keys, const void* values, const uint64_t n, const uint64_t nthreads);
+
+/**
+ * @brief Allocates a map that may be shared by any number of threads. The keys are spread over
+ * 2^shard_bits sub-maps by a multiplicative hash that is independent of the one that picks their
+ * home buckets. Every sub-map has its own reader-writer lock and resizes on its own, so threads
+ * that work on different shards never wait for each other. Returns NULL on failure.
+ * 
+ * @param shard_bits The base 2 logarithm of the number of shards (at most 16).
+ * @param initial_capacity The minimum initial capacity of the whole map, divided among the shards.
+ * @param value_size The size (in bytes) of the type of value to be stored in the map.
+ * @param flags A bitwise OR of FLATMAP56_* flags, passed on to every sub-map.
+ * @param policy The growth policy of every sub-map, or NULL for flatmap56_default_policy().
+ * @return flatmap56_sharded_t* 
+ */
+FLATMAP56_API flatmap56_sharded_t* flatmap56_sharded_create(const uint64_t shard_bits, const uint64_t initial_capacity, const uint64_t value_size, const uint64_t flags, const flatmap56_policy_t* policy);
+
+/**
+ * @brief Frees a map allocated with flatmap56_sharded_create(). No other thread may be using it.
+ * 
+ * @param map A pointer to the flatmap56_sharded_t object.
+ */
+FLATMAP56_API void flatmap56_sharded_destroy(flatmap56_sharded_t* map);
+
+/**
+ * @brief Returns the total number of entries in all of the shards. Each shard is counted under its
+ * lock, so the result is only exact if no other thread is changing the map.
+ * 
+ * @param map A pointer to the flatmap56_sharded_t object.
+ * @return uint64_t 
+ */
+FLATMAP56_API uint64_t flatmap56_sharded_size(flatmap56_sharded_t* map);
+
+/**
+ * @brief Copies the value associated with key into a buffer. The value is copied under the shard's
+ * read lock, because a pointer into the shard could be invalidated by another thread as soon as
+ * the lock is released. Returns true if the key exists, otherwise false.
+ * 
+ * @param map A pointer to the flatmap56_sharded_t object.
+ * @param key The key to lookup.
+ * @param value A buffer that receives the value, if it is not NULL.
+ * @return bool 
+ */
+FLATMAP56_API bool flatmap56_sharded_lookup(flatmap56_sharded_t* map, const uint64_t key, void* value);
+
+/**
+ * @brief Associates a copy of value with key, inserting the key if it does not exist yet. Returns
+ * false if the shard could not grow.
+ * 
+ * @param map A pointer to the flatmap56_sharded_t object.
+ * @param key The key to insert.
+ * @param value The value_size bytes to store, or NULL to store zeros for a new key and leave the
+ * value of an existing key unchanged.
+ * @return bool 
+ */
+FLATMAP56_API bool flatmap56_sharded_insert(flatmap56_sharded_t* map, const uint64_t key, const void* value);
+
+/**
+ * @brief Removes key and copies its value into a buffer. Returns true if the key existed.
+ * 
+ * @param map A pointer to the flatmap56_sharded_t object.
+ * @param key The key to remove.
+ * @param value A buffer that receives the value, if it is not NULL.
+ * @return bool 
+ */
+FLATMAP56_API bool flatmap56_sharded_remove(flatmap56_sharded_t* map, const uint64_t key, void* value);
+
+/**
+ * @brief Looks up n keys at once. The keys are grouped by shard, and each shard is locked only
+ * once and searched with flatmap56_lookup_batch().
+ * 
+ * @param map A pointer to the flatmap56_sharded_t object.
+ * @param keys An array of n keys to lookup.
+ * @param n The number of keys.
+ * @param values An array of n values of value_size bytes each that receives the values of the keys
+ * that were found. The elements for the other keys are left untouched.
+ * @return uint64_t The number of keys that were found.
+ */
+FLATMAP56_API uint64_t flatmap56_sharded_lookup_batch(flatmap56_sharded_t* map, const uint64_t* keys, const uint64_t n, void* values);
+
+/**
+ * @brief Inserts n keys at once, as if by flatmap56_sharded_insert(). The keys are grouped by
+ * shard and each shard is locked only once. Returns false if a shard could not grow, in which
+ * case some of the keys may have been inserted.
+ * 
+ * @param map A pointer to the flatmap56_sharded_t object.
+ * @param keys An array of n keys to insert.
+ * @param values An array of n values of value_size bytes each, or NULL.
+ * @param n The number of keys.
+ * @return bool 
+ */
+FLATMAP56_API bool flatmap56_sharded_insert_batch(flatmap56_sharded_t* map, const uint64_t* keys, const void* values, const uint64_t n);
+
+/**
+ * @brief Removes n keys at once. The keys are grouped by shard and each shard is locked only once.
+ * 
+ * @param map A pointer to the flatmap56_sharded_t object.
+ * @param keys An array of n keys to remove.
+ * @param n The number of keys.
+ * @param values An array of n values of value_size bytes each that receives the values of the
+ * removed keys, or NULL. The elements for keys that were not found are left untouched.
+ * @return uint64_t The number of keys that were removed.
+ */
+FLATMAP56_API uint64_t flatmap56_sharded_remove_batch(flatmap56_sharded_t* map, const uint64_t* keys, const uint64_t n, void* values);
+
+/**
+ * @brief Allocates a combining front end for map, through which any number of threads insert into
+ * it with few lock acquisitions. Every thread accumulates its entries in a flatmap56_buffer_t of its
+ * own; a full buffer is sorted by home bucket into a batch and published, and whichever thread
+ * holds the combiner lock merges every published batch into map. While the front end is in use map
+ * must only be changed through it; a FLATMAP56_CONCURRENT map may still be read with
+ * flatmap56_read(). Returns NULL on failure.
+ * 
+ * @param map The map that receives the entries. It is not owned by the combiner.
+ * @param merge Called to combine the value of a key that is already present (value) with another
+ * value for the same key (incoming), both in a buffer and in map. NULL lets the incoming value
+ * replace the present one.
+ * @param ctx Passed through to merge.
+ * @return flatmap56_combiner_t* 
+ */
+FLATMAP56_API flatmap56_combiner_t* flatmap56_combiner_create(flatmap56_t* map, void (*merge)(void* value, const void* incoming, void* ctx), void* ctx);
+
+/**
+ * @brief Merges every published batch into the map and frees the combiner. The map is left alone.
+ * 
+ * @param combiner A pointer to the flatmap56_combiner_t object.
+ */
+FLATMAP56_API void flatmap56_combiner_destroy(flatmap56_combiner_t* combiner);
+
+/**
+ * @brief Waits for the combiner lock and merges every batch published so far into the map. Once
+ * the buffers have been flushed, this makes all of their entries visible in the map.
+ * 
+ * @param combiner A pointer to the flatmap56_combiner_t object.
+ * @return bool False if an entry could not be inserted into the map at any time since the combiner
+ * was created.
+ */
+FLATMAP56_API bool flatmap56_combiner_sync(flatmap56_combiner_t* combiner);
+
+/**
+ * @brief Returns the number of batches merged into the map since the combiner was created. Only
+ * exact once the buffers have been flushed and flatmap56_combiner_sync() has returned.
+ * 
+ * @param combiner A pointer to the flatmap56_combiner_t object.
+ * @return uint64_t
+ */
+FLATMAP56_API uint64_t flatmap56_combiner_batches(const flatmap56_combiner_t* combiner);
+
+/**
+ * @brief Returns the number of times the combiner lock has been taken to merge batches since the
+ * combiner was created, which is at most one more than flatmap56_combiner_batches() if the
+ * threads rarely had to wait for each other. Only exact under the same conditions.
+ * 
+ * @param combiner A pointer to the flatmap56_combiner_t object.
+ * @return uint64_t
+ */
+FLATMAP56_API uint64_t flatmap56_combiner_combines(const flatmap56_combiner_t* combiner);
+
+/**
+ * @brief Allocates the private buffer of one thread. A buffer must only be used by one thread at a
+ * time. Returns NULL on failure.
+ * 
+ * @param combiner A pointer to the flatmap56_combiner_t object that the buffer feeds.
+ * @param capacity The number of distinct keys the buffer holds before it is flushed.
+ * @return flatmap56_buffer_t* 
+ */
+FLATMAP56_API flatmap56_buffer_t* flatmap56_buffer_create(flatmap56_combiner_t* combiner, const uint64_t capacity);
+
+/**
+ * @brief Flushes the buffer and frees it.
+ * 
+ * @param buffer A pointer to the flatmap56_buffer_t object.
+ */
+FLATMAP56_API void flatmap56_buffer_destroy(flatmap56_buffer_t* buffer);
+
+/**
+ * @brief Adds an entry to the buffer, merging it with the buffered value if the key is already
+ * there. The buffer is flushed once it holds capacity keys.
+ * 
+ * @param buffer A pointer to the flatmap56_buffer_t object.
+ * @param key The key to insert.
+ * @param value The value_size bytes of the map to insert or merge.
+ * @return bool False if the buffer could not hold the entry or the combiner has failed.
+ */
+FLATMAP56_API bool flatmap56_buffer_insert(flatmap56_buffer_t* buffer, const uint64_t key, const void* value);
+
+/**
+ * @brief Publishes the entries of the buffer as one batch sorted by home bucket and empties it.
+ * If the combiner lock is free the calling thread merges every published batch into the map,
+ * otherwise the batch is left to the thread that holds the lock. Does nothing if the buffer is
+ * empty.
+ * 
+ * @param buffer A pointer to the flatmap56_buffer_t object.
+ * @return bool False if the combiner has failed.
+ */
+FLATMAP56_API bool flatmap56_buffer_flush(flatmap56_buffer_t* buffer);
 
 #ifdef __cplusplus
 };
 #endif
 
+#ifdef FLATMAP56_HEADER_ONLY
+#include "geoseq_unordered_flatmap56.c"
+#endif
+
 #endif
\ No newline at end of file
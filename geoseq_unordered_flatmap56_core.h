@@ -0,0 +1,288 @@
+
+//          Copyright Christopher Smith 2022.
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          https://www.boost.org/LICENSE_1_0.txt)
+
+// The hot paths of geoseq_unordered_flatmap56 written once in terms of the header stride, the value
+// stride, the value size and whether the map keeps an occupancy bitmap. The generic functions in
+// geoseq_unordered_flatmap56.c pass the strides stored in the map and pick the bitmap variant from
+// it, while FLATMAP56_DEFINE() passes compile-time constants so that the compiler can turn every
+// index multiply into a shift and every value copy into a fixed-size move, and drop the bitmap.
+
+#ifndef _GEOSEQ_UNORDERED_FLAT_MAP_56_CORE_H_
+#define _GEOSEQ_UNORDERED_FLAT_MAP_56_CORE_H_
+
+#ifndef __cplusplus
+#include <string.h>
+#else
+#include <cstring>
+#endif
+#include "geoseq_unordered_flatmap56.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLATMAP56_EMPTY_SLOT                0
+#define FLATMAP56_NO_MORE_PROBES            (MAX_PROBES-1)
+#define FLATMAP56_ROUND_UP_8(N)             (((N) + 7) & ~((uint64_t)7))
+#define FLATMAP56_HASH_MULTIPLIER           11400714819323198103ul
+#define FLATMAP56_HASH(MAP,KEY)             (((KEY) * FLATMAP56_HASH_MULTIPLIER) >> (MAP)->hash_shift)
+#define FLATMAP56_CALC_INDEX(MAP,H,P)       (((H) + (MAP)->probes[P]) & (MAP)->table_mask)
+// the index in a FLATMAP56_GROUPED_LAYOUT table: probes smaller than a block wrap around inside the
+// home block, larger ones move whole blocks
+#define FLATMAP56_CALC_INDEX_GROUPED(MAP,H,P) (((((H) & ~(MAP)->block_mask) + ((MAP)->probes[P] & ~(MAP)->block_mask)) | \
+                                                (((H) + (MAP)->probes[P]) & (MAP)->block_mask)) & (MAP)->table_mask)
+// the index in a grouped table if GL is true; GL is a constant in every instance of the core
+// functions, like BM
+#define FLATMAP56_INDEX(MAP,H,P,GL)         ((GL) ? FLATMAP56_CALC_INDEX_GROUPED(MAP,H,P) : FLATMAP56_CALC_INDEX(MAP,H,P))
+#define FLATMAP56_BUCKET_AT(MAP,INDEX,HS)   ((bucket_t*)(&(MAP)->buckets[(INDEX) * (HS)]))
+#define FLATMAP56_VALUE_AT(MAP,INDEX,VS)    ((void*)(&(MAP)->values[(INDEX) * (VS)]))
+#define FLATMAP56_EMPLACE_EMPTY(BUCKET,KEY,NEXT,DIRECT) \
+    BUCKET->unique_key = KEY; \
+    BUCKET->next_probe = NEXT; \
+    BUCKET->direct_hit = DIRECT
+// thresholds derived from the map's policy; see flatmap56_create_ex()
+#define FLATMAP56_SHOULD_GROW(MAP)          ((MAP)->num_entries >= (MAP)->grow_at)
+#define FLATMAP56_SHOULD_SHRINK(MAP)        ((MAP)->num_entries < (MAP)->shrink_below)
+#define FLATMAP56_FORCE_INLINE              static inline __attribute__((always_inline))
+// true if bucket INDEX is empty, answered from the occupancy bitmap if BM says the map has one; BM
+// is a constant in every instance of the core functions, so each instance tests one or the other
+#define FLATMAP56_IS_EMPTY(MAP,INDEX,HS,BM) ((BM) ? !(((MAP)->occupancy[(INDEX) >> 6] >> ((INDEX) & 63)) & 1) : \
+                                             FLATMAP56_BUCKET_AT(MAP,INDEX,HS)->next_probe == FLATMAP56_EMPTY_SLOT)
+#define FLATMAP56_MARK_OCCUPIED(MAP,INDEX,BM) if(BM) (MAP)->occupancy[(INDEX) >> 6] |= 1ul << ((INDEX) & 63)
+#define FLATMAP56_MARK_EMPTY(MAP,INDEX,BM)  if(BM) (MAP)->occupancy[(INDEX) >> 6] &= ~(1ul << ((INDEX) & 63))
+// true if bucket INDEX may be used by an emplace restricted to RANGE (NULL means the whole table)
+#define FLATMAP56_IN_RANGE(RANGE,INDEX)     (!(RANGE) || (INDEX) - (RANGE)->lo < (RANGE)->hi - (RANGE)->lo)
+
+// A half-open range of bucket indices. An emplace restricted to a range neither reads nor writes
+// any bucket outside of it, so threads that own disjoint ranges may emplace at the same time.
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+}flatmap56_range_t;
+
+/**
+ * @brief Rebuilds the table with policy.growth_factor times as many buckets if action > 0, half as
+ * many if action < 0, or the same number if action == 0. Returns false and leaves the map untouched
+ * on failure.
+ */
+FLATMAP56_API bool flatmap56_resize(flatmap56_t* map, int action);
+
+FLATMAP56_FORCE_INLINE void* flatmap56_core_find(const flatmap56_t* map, const uint64_t key, const uint64_t h, const uint64_t hs, const uint64_t vs) {
+    uint64_t  i = h;
+    bucket_t* b = FLATMAP56_BUCKET_AT(map,i,hs);
+    if(b->unique_key == key) return FLATMAP56_VALUE_AT(map,i,vs);
+    if(b->direct_hit){
+        while(b->next_probe != FLATMAP56_NO_MORE_PROBES){
+            i = FLATMAP56_CALC_INDEX(map,h,b->next_probe);
+            b = FLATMAP56_BUCKET_AT(map,i,hs);
+            if(b->unique_key == key) return FLATMAP56_VALUE_AT(map,i,vs);
+        }
+    }
+    return NULL;
+}
+
+FLATMAP56_FORCE_INLINE void* flatmap56_core_emplace_direct(flatmap56_t* map, const uint64_t key, const uint64_t h, const uint64_t hs, const uint64_t vs, const bool bm, const bool gl, const flatmap56_range_t* range){
+
+    bucket_t* temp;
+    bucket_t* empty = NULL;
+    bucket_t* predecessor = NULL;
+    uint64_t  i, empty_index = 0;
+    uint8_t   x, y, z, empty_next = FLATMAP56_NO_MORE_PROBES, empty_probe = 0;
+
+    for(x = 0; x < FLATMAP56_NO_MORE_PROBES; x = z){
+        i = FLATMAP56_INDEX(map,h,x,gl);
+        temp = FLATMAP56_BUCKET_AT(map,i,hs);
+        if(temp->unique_key == key) return FLATMAP56_VALUE_AT(map,i,vs);
+        z = temp->next_probe;
+        if(!empty){
+            for(y = x + 1; y < z; y++){
+                i = FLATMAP56_INDEX(map,h,y,gl);
+                if(FLATMAP56_IN_RANGE(range,i) && FLATMAP56_IS_EMPTY(map,i,hs,bm)){
+                    predecessor = temp;
+                    empty = FLATMAP56_BUCKET_AT(map,i,hs);
+                    empty_index = i;
+                    empty_probe = y;
+                    empty_next = z;
+                    break;
+                }
+            }
+        }
+    }
+
+    if(empty){
+        FLATMAP56_MARK_OCCUPIED(map,empty_index,bm);
+        FLATMAP56_EMPLACE_EMPTY(empty, key, empty_next, 0);
+        predecessor->next_probe = empty_probe;
+        map->num_entries++;
+        return FLATMAP56_VALUE_AT(map,empty_index,vs);
+    }
+
+    return NULL;
+}
+
+FLATMAP56_FORCE_INLINE void* flatmap56_core_emplace_indirect(flatmap56_t* map, const uint64_t key, const uint64_t h, const uint64_t hs, const uint64_t vs, const uint64_t vz, const bool bm, const bool gl, const flatmap56_range_t* range){
+
+    bucket_t* temp;
+    bucket_t* empty = NULL;
+    bucket_t* predecessor = NULL;
+    bucket_t* gap = NULL; // the chain element that the relocated entry will follow
+    bucket_t* b = FLATMAP56_BUCKET_AT(map,h,hs);
+    uint64_t  i, empty_index = 0;
+    uint8_t   x, y, z, empty_probe = 0, empty_next = 0;
+
+    uint64_t h2 = FLATMAP56_HASH(map, b->unique_key);
+
+    for(x = 0; x < FLATMAP56_NO_MORE_PROBES; x = z){
+
+        temp = FLATMAP56_BUCKET_AT(map,FLATMAP56_INDEX(map,h2,x,gl),hs);
+        z = temp->next_probe;
+
+        if(!predecessor){
+            if(h == FLATMAP56_INDEX(map,h2,z,gl)){
+                predecessor = temp;
+                z = b->next_probe; // skip over b
+            }
+        }
+
+        if(!empty){
+            for(y = x + 1; y < z; y++){
+                i = FLATMAP56_INDEX(map,h2,y,gl);
+                if(FLATMAP56_IN_RANGE(range,i) && FLATMAP56_IS_EMPTY(map,i,hs,bm)){
+                    empty = FLATMAP56_BUCKET_AT(map,i,hs);
+                    empty_index = i;
+                    empty_probe = y;
+                    empty_next = z;
+                    gap = temp;
+                    break;
+                }
+            }
+        }
+
+        if(predecessor && empty){
+            // nothing is modified until both buckets are known, so a failure leaves every chain intact
+            predecessor->next_probe = b->next_probe;
+            FLATMAP56_MARK_OCCUPIED(map,empty_index,bm);
+            FLATMAP56_EMPLACE_EMPTY(empty,b->unique_key,empty_next,0);
+            memcpy(FLATMAP56_VALUE_AT(map,empty_index,vs), FLATMAP56_VALUE_AT(map,h,vs), vz);
+            gap->next_probe = empty_probe;
+            FLATMAP56_EMPLACE_EMPTY(b, key, FLATMAP56_NO_MORE_PROBES, 1);
+            memset(FLATMAP56_VALUE_AT(map,h,vs), 0, vz);
+            map->num_entries++;
+            return FLATMAP56_VALUE_AT(map,h,vs);
+        }
+    }
+
+    return NULL;
+}
+
+// Emplaces key using only the buckets in range, whose home bucket must lie inside it. Every bucket
+// of a chain is in the same range as its home, because only emplaces restricted to that range ever
+// linked them. Returns NULL if there is no free bucket for key inside the range.
+FLATMAP56_FORCE_INLINE void* flatmap56_core_emplace_range(flatmap56_t* map, const uint64_t key, const uint64_t hs, const uint64_t vs, const uint64_t vz, const bool bm, const bool gl, const flatmap56_range_t* range) {
+    uint64_t  h = FLATMAP56_HASH(map,key);
+    bucket_t* b = FLATMAP56_BUCKET_AT(map,h,hs);
+    if(b->next_probe == FLATMAP56_EMPTY_SLOT){
+        FLATMAP56_MARK_OCCUPIED(map,h,bm);
+        FLATMAP56_EMPLACE_EMPTY(b,key,FLATMAP56_NO_MORE_PROBES,1);
+        map->num_entries++;
+        return FLATMAP56_VALUE_AT(map,h,vs);
+    }
+    if(b->direct_hit) return flatmap56_core_emplace_direct(map,key,h,hs,vs,bm,gl,range);
+    return flatmap56_core_emplace_indirect(map,key,h,hs,vs,vz,bm,gl,range);
+}
+
+FLATMAP56_FORCE_INLINE void* flatmap56_core_emplace(flatmap56_t* map, const uint64_t key, const uint64_t hs, const uint64_t vs, const uint64_t vz, const bool bm, const bool gl) {
+    return flatmap56_core_emplace_range(map, key, hs, vs, vz, bm, gl, NULL);
+}
+
+// Unlinks key from its chain without ever resizing the table. Returns true if the key was found.
+FLATMAP56_FORCE_INLINE bool flatmap56_core_unlink(flatmap56_t* map, const uint64_t key, void* value, const uint64_t hs, const uint64_t vs, const uint64_t vz, const bool bm, const bool gl) {
+
+    uint64_t  h = FLATMAP56_HASH(map,key);
+    uint64_t  i = h, i2;
+    bucket_t* b = FLATMAP56_BUCKET_AT(map,i,hs);
+    bucket_t* b2 = NULL;
+
+    if(b->direct_hit){
+        for(;;){
+            if(b->unique_key == key){
+                if(value) memcpy(value, FLATMAP56_VALUE_AT(map,i,vs), vz);
+                if(b2){ // not the head of the list
+                    b2->next_probe = b->next_probe;
+                }
+                else if(b->next_probe != FLATMAP56_NO_MORE_PROBES){
+                    i2 = FLATMAP56_INDEX(map,h,b->next_probe,gl);
+                    b2 = FLATMAP56_BUCKET_AT(map,i2,hs);
+                    b->next_probe = b2->next_probe;
+                    b->unique_key = b2->unique_key;
+                    memcpy(FLATMAP56_VALUE_AT(map,i,vs), FLATMAP56_VALUE_AT(map,i2,vs), vz);
+                    b = b2;
+                    i = i2;
+                }
+                memset(b,0,sizeof(bucket_t));
+                FLATMAP56_MARK_EMPTY(map,i,bm);
+                memset(FLATMAP56_VALUE_AT(map,i,vs),0,vz);
+                map->num_entries--;
+                return true;
+            }
+            b2 = b; // remember the previous bucket_t
+            if(b->next_probe == FLATMAP56_NO_MORE_PROBES) break;
+            i = FLATMAP56_INDEX(map,h,b->next_probe,gl);
+            b = FLATMAP56_BUCKET_AT(map,i,hs);
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Emits a family of static functions named PREFIX_create, PREFIX_destroy, PREFIX_lookup,
+ * PREFIX_insert, PREFIX_try_emplace and PREFIX_remove that are specialized for values of type VALUE_TYPE. The bucket
+ * stride and the value size are compile-time constants in these functions, so the hot path needs
+ * no runtime multiplies or variable-length copies, and it never checks for an occupancy bitmap,
+ * which the maps of PREFIX_create() do not have. The maps they operate on are ordinary
+ * flatmap56_t objects, so every other flatmap56_* function may be used on them as well. They must
+ * only be given maps that were created with PREFIX_create().
+ */
+#define FLATMAP56_DEFINE(PREFIX,VALUE_TYPE) \
+    static inline flatmap56_t* PREFIX##_create(const uint64_t initial_capacity) { \
+        return flatmap56_create(initial_capacity, sizeof(VALUE_TYPE)); \
+    } \
+    static inline void PREFIX##_destroy(flatmap56_t* map) { \
+        flatmap56_destroy(map); \
+    } \
+    static inline VALUE_TYPE* PREFIX##_lookup(const flatmap56_t* map, const uint64_t key) { \
+        return (VALUE_TYPE*)flatmap56_core_find(map, key, FLATMAP56_HASH(map,key), \
+            FLATMAP56_ROUND_UP_8(sizeof(bucket_t) + sizeof(VALUE_TYPE)), \
+            FLATMAP56_ROUND_UP_8(sizeof(bucket_t) + sizeof(VALUE_TYPE))); \
+    } \
+    static inline VALUE_TYPE* PREFIX##_insert(flatmap56_t* map, const uint64_t key) { \
+        if(FLATMAP56_SHOULD_GROW(map)) return (VALUE_TYPE*)flatmap56_insert(map, key); \
+        VALUE_TYPE* value = (VALUE_TYPE*)flatmap56_core_emplace(map, key, \
+            FLATMAP56_ROUND_UP_8(sizeof(bucket_t) + sizeof(VALUE_TYPE)), \
+            FLATMAP56_ROUND_UP_8(sizeof(bucket_t) + sizeof(VALUE_TYPE)), sizeof(VALUE_TYPE), false, false); \
+        if(!value) value = (VALUE_TYPE*)flatmap56_insert(map, key); /* the table must grow */ \
+        return value; \
+    } \
+    static inline VALUE_TYPE* PREFIX##_try_emplace(flatmap56_t* map, const uint64_t key, bool* inserted) { \
+        uint64_t size = map->num_entries; \
+        VALUE_TYPE* value = PREFIX##_insert(map, key); \
+        *inserted = map->num_entries != size; \
+        return value; \
+    } \
+    static inline bool PREFIX##_remove(flatmap56_t* map, const uint64_t key, VALUE_TYPE* value) { \
+        if(!flatmap56_core_unlink(map, key, value, \
+            FLATMAP56_ROUND_UP_8(sizeof(bucket_t) + sizeof(VALUE_TYPE)), \
+            FLATMAP56_ROUND_UP_8(sizeof(bucket_t) + sizeof(VALUE_TYPE)), sizeof(VALUE_TYPE), false, false)) return false; \
+        if(FLATMAP56_SHOULD_SHRINK(map)) flatmap56_resize(map,-1); \
+        return true; \
+    }
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif
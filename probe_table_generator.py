@@ -0,0 +1,68 @@
+#          Copyright Christopher Smith 2022.
+# Distributed under the Boost Software License, Version 1.0.
+#    (See accompanying file LICENSE_1_0.txt or copy at
+#          https://www.boost.org/LICENSE_1_0.txt)
+
+
+# PLEASE NOTE: The purpose of this file is to generate the read-only
+# probe sequence tables used by geoseq_unordered_flatmap56. There is
+# one table for each table size from 2^7 to 2^64 buckets, derived from
+# the common ratios calculated by common_ratio_calculator.py. Run it as
+#
+#     $ python3 probe_table_generator.py > geoseq_probe_tables.h
+
+
+import math
+import struct
+from common_ratio_calculator import calculate_common_ratios
+
+# The number of entries in each table.
+# Same as MAX_PROBES in geoseq_unordered_flatmap56.h.
+max_probes = 128
+
+# Rounds a ratio to the nearest single precision float, which
+# is the precision the ratios have always been stored with.
+def to_float(ratio) -> float:
+    return struct.unpack('f', struct.pack('f', ratio))[0]
+
+# Calculates the probe sequence for one table size. The first and the
+# last entries are reserved for the empty slot and the end of a chain.
+def probe_sequence(ratio):
+    ratio = to_float(ratio)
+    probes = [0]
+    p = 1.0
+    for _ in range(1, max_probes - 1):
+        probes.append(int(p))
+        p = float(math.ceil(p * ratio))
+    probes.append(0)
+    return probes
+
+
+if __name__ == '__main__':
+
+    ratios = calculate_common_ratios()
+
+    print('//          Copyright Christopher Smith 2022.')
+    print('// Distributed under the Boost Software License, Version 1.0.')
+    print('//    (See accompanying file LICENSE_1_0.txt or copy at')
+    print('//          https://www.boost.org/LICENSE_1_0.txt)')
+    print()
+    print('// This file is generated by probe_table_generator.py. Do not edit it by hand.')
+    print()
+    print('#ifndef _GEOSEQ_PROBE_TABLES_H_')
+    print('#define _GEOSEQ_PROBE_TABLES_H_')
+    print()
+    print(f'#define MIN_TABLE_BITS      7')
+    print(f'#define NUM_PROBE_TABLES    {len(ratios)}')
+    print()
+    print('static const uint64_t probe_tables[NUM_PROBE_TABLES][MAX_PROBES] = {')
+    for bits, ratio in enumerate(ratios, 7):
+        probes = probe_sequence(ratio)
+        print(f'    {{ // 2^{bits} buckets, common ratio {ratio}')
+        for i in range(0, max_probes, 8):
+            row = ', '.join(f'{p}ul' for p in probes[i:i+8])
+            print(f'        {row}{"," if i + 8 < max_probes else ""}')
+        print('    }' + (',' if bits - 7 + 1 < len(ratios) else ''))
+    print('};')
+    print()
+    print('#endif')